@@ -37,11 +37,16 @@
 #define strcasecmp _stricmp
 #endif
 
+//-- template edition, fixed message length (rsha256_fixed_*.h)
+#include "rsha256_fixed_x64.h"
+#include "rsha256_fixed_arm.h"
+
 //-- external functions, recursive SHA256 (rsha256_fast_*.cxx, rsha256_ref_*.cxx)
 void rsha256_fast(uint8_t* hash,const uint64_t num_iters);
 void rsha256_ref(uint8_t* hash,const uint64_t num_iters);
 
 //-- local functions
+void local_Fixed32(uint8_t* hash,const uint64_t num_iters);
 void local_ANSISetup(void);
 void local_ANSIRestore(void);
 void local_InitHashVerify();
@@ -97,6 +102,9 @@ int main(int argc, char* argv[])
  //-- benchmark - fast (rsha256_fast_*.cxx)
  if(local_Benchmark(&rsha256_fast,"Fast:")){ return 1; };
 
+ //-- benchmark - fixed, 32bytes message (rsha256_fixed_*.h)
+ if(local_Benchmark(&local_Fixed32,"Fixed:")){ return 1; };
+
  //-- benchmark - reference (rsha256_ref_*.cxx)
  if(local_Benchmark(&rsha256_ref,"Reference:")){ return 1; };
 
@@ -106,6 +114,16 @@ int main(int argc, char* argv[])
  return 0;
 }
 
+//-- local_Fixed32() - rsha256_fixed<32,32>(), same message as rsha256_fast()
+void local_Fixed32(uint8_t* hash,const uint64_t num_iters)
+{
+#if defined(__amd64__) || defined(_M_AMD64) || defined(__aarch64__) || defined(_M_ARM64)
+ rsha256_fixed<32,32>(hash,num_iters);
+#else
+ rsha256_ref(hash,num_iters);
+#endif
+}
+
 //-- local_ParseParameters() - parse parameters
 void local_ParseParameters(int argc,char* argv[])
 {
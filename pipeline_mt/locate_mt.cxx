@@ -0,0 +1,365 @@
+/*
+ * File: locate_mt.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Locate first bad iteration in a failing VDF segment, with fast recursive SHA256
+ * Multithreaded, k-ary bisection of sub-ranges verified in parallel (rsha256pl_locate.cxx)
+ *
+ * Program call: locate_mt -i <iters> -c <subiters> -x <fault> -s <hash> -f <file> -r <file> -t <threads>
+ *
+ * -i <iters>: Number of SHA256 iterations in segment (optional)
+ *             Default 100M, K/M/G suffix (1000), with -f: sub-checkpoints x subiters
+ *
+ * -c <subiters>: Number of SHA256 iterations between sub-checkpoints (optional)
+ *                Default 1M, K/M/G suffix (1000)
+ *
+ * -x <fault>: Simulate creator with bad iteration <fault> (optional, default)
+ *             Default 61.8% of iterations, 1st bit of hash flipped
+ *             Locates by sub-checkpoints, then by creator recompute inside
+ *
+ * -s <hash>: 64 hex chars, hash/data at start of segment (optional)
+ *            Default 2EFD64A5... (same as benchmark_mt)
+ *
+ * -f <file>: Locate in creator sub-checkpoints of file (optional)
+ *            32bytes binary hash/data every <subiters>, last is end
+ *
+ * -r <file>: Record sub-checkpoints of segment to file (optional)
+ *            Recompute from <hash>, <iters>, every <subiters>
+ *
+ * -t <threads>: Number of threads to run (optional)
+ *               Default 0 (by CPU budget), 256 (max)
+ *
+ * Requirement: Intel/AMD x64 CPU, with SHA Extensions, or
+ *              ARM CPU, with Cryptography Extensions
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <vector>
+
+#include "rsha256pl_verify.h"
+
+//-- creator simulated, sub-checkpoints recorded with bad iteration, recompute from them inside
+struct local_simcreator {
+ rsha256_subcps subcps;
+ const uint8_t* start;
+ uint64_t       fault;
+ };
+
+//-- local functions
+void local_ANSISetup(void);
+void local_ANSIRestore(void);
+void local_ParseParameters(int argc,char* argv[]);
+uint64_t local_ParseIters(const char* str);
+bool local_ParseHash(uint8_t* hash,const char* str);
+void local_PrintHash(const uint8_t* hash);
+double local_Seconds(void);
+void local_SimRun(uint8_t* hash,uint64_t from,uint64_t iters,uint64_t fault);
+uint64_t local_SimFunc(void* ctx,const uint64_t iter,uint8_t* hash);
+int local_Simulate(void);
+int local_LocateFile(void);
+int local_RecordFile(void);
+
+//-- local parameter values
+uint64_t    local_iters;
+bool        local_itersset;
+uint64_t    local_subiters;
+uint64_t    local_fault;
+uint8_t     local_start[32];
+const char* local_file;
+uint32_t    local_mode;
+uint32_t    local_threads;
+
+//-- main() - entrypoint
+int main(int argc, char* argv[])
+{
+ int ret;
+
+ //-- setup/init ANSI capability
+ local_ANSISetup();
+
+ //-- default parameter values, -i 100M, -c 1M, -x 61.8%, -s 2EFD64A5..., -t 0
+ static const uint8_t hash_0[32] = { 0x2E,0xFD,0x64,0xA5,0x54,0x63,0xB5,0xB5,0x54,0xC4,0xA2,0xE2,0x2A,0x47,0x2D,0xA2,0x3B,0xB7,0x6E,0x63,0x75,0x8C,0xE3,0xC8,0x92,0x76,0xAB,0xF0,0xE9,0xAD,0x8B,0x15 };
+ local_iters = 100000000;
+ local_itersset = false;
+ local_subiters = 1000000;
+ local_fault = 0;
+ memcpy(local_start,hash_0,32);
+ local_file = NULL;
+ local_mode = 0;
+ local_threads = 0;
+
+ //-- display header
+ setvbuf(stdout,NULL,_IONBF,0);
+ printf("\33[1;97m[Locate (mt) - First bad iteration in VDF segment]\33[0m\n");
+
+ //-- parse parameters
+ local_ParseParameters(argc,argv);
+
+ //-- mode: 0 = simulate, 1 = locate in file, 2 = record to file
+ if     (local_mode == 1){ ret = local_LocateFile(); }
+ else if(local_mode == 2){ ret = local_RecordFile(); }
+ else                    { ret = local_Simulate(); }
+
+ //-- restore ANSI capability
+ local_ANSIRestore();
+
+ return ret;
+}
+
+//-- local_ParseParameters() - parse parameters
+void local_ParseParameters(int argc,char* argv[])
+{
+ for(int i = 1, jP = 0; i < argc; ++i){
+   if((char)jP == 'i'){
+     local_iters = local_ParseIters(argv[i]);
+     local_itersset = (local_iters >= 1);
+     if(local_iters < 1){ local_iters = 100000000; }
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 'c'){
+     local_subiters = local_ParseIters(argv[i]);
+     if(local_subiters < 1){ local_subiters = 1000000; }
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 'x'){
+     local_fault = local_ParseIters(argv[i]);
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 's'){
+     if(!local_ParseHash(local_start,argv[i])){ printf("- \33[1;33mINFO: Invalid -s <hash>, 64 hex chars. Using default.\33[0m\n"); }
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 'f' || (char)jP == 'r'){
+     local_file = argv[i];
+     local_mode = ((char)jP == 'f') ? 1 : 2;
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 't'){
+     local_threads = atoi(argv[i]);
+     if(local_threads > 256){ local_threads = 0; }
+     }
+
+   jP = 0;
+   if(!strcmp(argv[i],"-i")){ jP = 'i'; continue; }
+   if(!strcmp(argv[i],"-c")){ jP = 'c'; continue; }
+   if(!strcmp(argv[i],"-x")){ jP = 'x'; continue; }
+   if(!strcmp(argv[i],"-s")){ jP = 's'; continue; }
+   if(!strcmp(argv[i],"-f")){ jP = 'f'; continue; }
+   if(!strcmp(argv[i],"-r")){ jP = 'r'; continue; }
+   if(!strcmp(argv[i],"-t")){ jP = 't'; continue; }
+   }
+
+ if(local_fault < 1 || local_fault > local_iters){ local_fault = (uint64_t)((double)local_iters * 0.618); }
+ if(local_fault < 1){ local_fault = 1; }
+}
+
+//-- local_ParseIters() - number, with optional K/M/G suffix (1000)
+uint64_t local_ParseIters(const char* str)
+{
+ char* tail;
+ uint64_t val = strtoull(str,&tail,10);
+ if     (*tail == 'K' || *tail == 'k'){ val *= 1000; }
+ else if(*tail == 'M' || *tail == 'm'){ val *= 1000000; }
+ else if(*tail == 'G' || *tail == 'g'){ val *= 1000000000; }
+ return val;
+}
+
+//-- local_ParseHash() - 64 hex chars to 32bytes
+bool local_ParseHash(uint8_t* hash,const char* str)
+{
+ uint8_t tmp[32];
+ if(strlen(str) != 64) return false;
+ for(uint32_t i = 0; i < 32; ++i){
+   char byte[3] = { str[2 * i], str[2 * i + 1], 0 };
+   char* tail;
+   tmp[i] = (uint8_t)strtoul(byte,&tail,16);
+   if(*tail != 0) return false;
+   }
+ memcpy(hash,tmp,32);
+ return true;
+}
+
+//-- local_PrintHash() - 32bytes as hex
+void local_PrintHash(const uint8_t* hash)
+{
+ for(uint32_t i = 0; i < 32; ++i){ printf("%02X",hash[i]); }
+}
+
+//-- local_Seconds() - monotonic time in seconds
+double local_Seconds(void)
+{
+ return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//-- local_SimRun() - iterations of simulated creator, hash/data at iteration fault has 1st bit flipped
+void local_SimRun(uint8_t* hash,uint64_t from,uint64_t iters,uint64_t fault)
+{
+ if(from < fault && from + iters >= fault){
+   rsha256_fast_x1(hash,fault - from);
+   hash[0] ^= 0x01;
+   iters -= fault - from;
+   }
+ rsha256_fast_x1(hash,iters);
+}
+
+//-- local_SimFunc() - rsha256_locfunc of simulated creator, recompute from its own sub-checkpoints
+uint64_t local_SimFunc(void* ctx,const uint64_t iter,uint8_t* hash)
+{
+ local_simcreator* sim = (local_simcreator*)ctx;
+ uint64_t base = rsha256_locate_subcps(&sim->subcps,iter,hash);
+ if(base == 0){ memcpy(hash,sim->start,32); }
+ local_SimRun(hash,base,iter - base,sim->fault);
+ return iter;
+}
+
+//-- local_Simulate() - creator with bad iteration, locate by sub-checkpoints, then by recompute inside
+int local_Simulate(void)
+{
+ double timestart;
+ uint64_t good;
+ uint64_t bad;
+
+ printf("- Parameters: %" PRIu64 " (iterations), %" PRIu64 " (sub-checkpoint every), %" PRIu64 " (bad iteration), %d (threads, 0 = budget)\n",local_iters,local_subiters,local_fault,local_threads);
+
+ //-- creator, sub-checkpoints with bad iteration
+ printf("- Creator: Recording sub-checkpoints with bad iteration ...");
+ std::vector<uint8_t> subhashes(32 * ((local_iters + local_subiters - 1) / local_subiters));
+ local_simcreator sim;
+ sim.subcps.hashes = subhashes.data();
+ sim.subcps.num = 0;
+ sim.subcps.sub_iters = local_subiters;
+ sim.start = local_start;
+ sim.fault = local_fault;
+
+ uint8_t hash[32];
+ memcpy(hash,local_start,32);
+ for(uint64_t done = 0; done < local_iters; done += local_subiters){
+   uint64_t run = (local_iters - done < local_subiters) ? local_iters - done : local_subiters;
+   local_SimRun(hash,done,run,local_fault);
+   memcpy(&subhashes[32 * sim.subcps.num++],hash,32);
+   }
+ const uint8_t* end = &subhashes[32 * (sim.subcps.num - 1)];
+
+ //-- locate by sub-checkpoints only
+ printf("\33[2K\r- Verifier: Locate by %" PRIu64 " sub-checkpoints ...",sim.subcps.num);
+ timestart = local_Seconds();
+ if(!rsha256_locate(&good,&bad,local_start,end,local_iters,&rsha256_locate_subcps,&sim.subcps,0,local_threads)){
+   fprintf(stderr,"\n\33[1;31mERROR: Segment verified ok, bad iteration not found !\33[0m\n");
+   return 1;
+   }
+ printf("\33[2K\r- Sub-checkpoints: bad iteration in (%" PRIu64 ", %" PRIu64 "] \33[1;32m%.2f\33[0m sec\n",good,bad,local_Seconds() - timestart);
+
+ //-- locate by creator recompute inside sub-checkpoints
+ printf("- Verifier: Locate by creator recompute ...");
+ timestart = local_Seconds();
+ rsha256_locate(&good,&bad,local_start,end,local_iters,&local_SimFunc,&sim,0,local_threads);
+ bool hashok = (bad == good + 1 && bad == local_fault);
+ printf("\33[2K\r- Creator recompute: bad iteration \33[1;32m%" PRIu64 "\33[0m \33[1;32m%.2f\33[0m sec [expected: %s]\n",bad,local_Seconds() - timestart,(hashok) ? "\33[1;32mok\33[0m" : "\33[1;31mERROR\33[0m");
+ if(!hashok){ fprintf(stderr,"\33[1;31mERROR: Located iteration %" PRIu64 " do not match simulated bad iteration %" PRIu64 " !\33[0m\n",bad,local_fault); return 1; }
+
+ return 0;
+}
+
+//-- local_LocateFile() - locate in creator sub-checkpoints of file
+int local_LocateFile(void)
+{
+ FILE* file = fopen(local_file,"rb");
+ if(file == NULL){ fprintf(stderr,"\33[1;31mERROR: Cannot open file %s !\33[0m\n",local_file); return 1; }
+ std::vector<uint8_t> subhashes;
+ uint8_t hash[32];
+ while(fread(hash,1,32,file) == 32){ subhashes.insert(subhashes.end(),hash,hash + 32); }
+ fclose(file);
+ if(subhashes.empty()){ fprintf(stderr,"\33[1;31mERROR: No sub-checkpoints in file %s !\33[0m\n",local_file); return 1; }
+
+ rsha256_subcps subcps;
+ subcps.hashes = subhashes.data();
+ subcps.num = subhashes.size() / 32;
+ subcps.sub_iters = local_subiters;
+
+ //-- iterations by file, unless -i given inside last sub-checkpoint (partial)
+ uint64_t iters = subcps.num * local_subiters;
+ if(local_itersset && local_iters > (subcps.num - 1) * local_subiters && local_iters < iters){ iters = local_iters; }
+
+ printf("- Parameters: %" PRIu64 " (iterations), %" PRIu64 " (sub-checkpoints), %" PRIu64 " (sub-checkpoint every), %d (threads, 0 = budget)\n",iters,subcps.num,local_subiters,local_threads);
+ printf("- Start: ");
+ local_PrintHash(local_start);
+ printf("\n");
+
+ //-- all sub-checkpoints verified, 1st failing sub-range (not only bisection points)
+ std::vector<rsha256_vseg> segs(subcps.num);
+ for(uint64_t i = 0; i < subcps.num; ++i){
+   segs[i].start = (i == 0) ? local_start : &subhashes[32 * (i - 1)];
+   segs[i].end = &subhashes[32 * i];
+   segs[i].iters = (i + 1 < subcps.num) ? local_subiters : iters - i * local_subiters;
+   }
+
+ double timestart = local_Seconds();
+ uint64_t fail = rsha256_verify_segs(segs.data(),(uint32_t)subcps.num,local_threads,NULL);
+ if(fail == subcps.num){
+   printf("- Segment: \33[1;32mok\33[0m %.2f sec\n",local_Seconds() - timestart);
+   return 0;
+   }
+ printf("- Segment: \33[1;31mbad\33[0m, first bad iteration in (%" PRIu64 ", %" PRIu64 "], sub-checkpoint %" PRIu64 " %.2f sec\n",fail * local_subiters,fail * local_subiters + segs[fail].iters,fail,local_Seconds() - timestart);
+ return 2;
+}
+
+//-- local_RecordFile() - recompute segment, record sub-checkpoints to file
+int local_RecordFile(void)
+{
+ printf("- Parameters: %" PRIu64 " (iterations), %" PRIu64 " (sub-checkpoint every)\n",local_iters,local_subiters);
+ std::vector<uint8_t> subhashes(32 * ((local_iters + local_subiters - 1) / local_subiters));
+ double timestart = local_Seconds();
+ uint64_t num = rsha256_locate_record(subhashes.data(),local_start,local_iters,local_subiters);
+
+ FILE* file = fopen(local_file,"wb");
+ if(file == NULL){ fprintf(stderr,"\33[1;31mERROR: Cannot create file %s !\33[0m\n",local_file); return 1; }
+ size_t written = fwrite(subhashes.data(),32,num,file);
+ fclose(file);
+ if(written != num){ fprintf(stderr,"\33[1;31mERROR: Cannot write file %s !\33[0m\n",local_file); return 1; }
+
+ printf("- Recorded: %" PRIu64 " sub-checkpoints to %s %.2f sec\n- End: ",num,local_file,local_Seconds() - timestart);
+ local_PrintHash(&subhashes[32 * (num - 1)]);
+ printf("\n");
+ return 0;
+}
+
+//-- local_ANSISetup() - setup/init ANSI capability (needed for Windows)
+//-- local_ANSIRestore() - restore ANSI capability (needed for Windows)
+#ifdef _WIN32
+#include <windows.h>
+static HANDLE local_win_stdout;
+static DWORD  local_win_savemode = 0;
+void local_ANSISetup(void)
+{
+ local_win_stdout = GetStdHandle(STD_OUTPUT_HANDLE);
+ if(local_win_stdout == INVALID_HANDLE_VALUE){ return; }
+ if(!GetConsoleMode(local_win_stdout,&local_win_savemode)){ local_win_savemode = 0; return; }
+ if(!SetConsoleMode(local_win_stdout,(local_win_savemode | ENABLE_VIRTUAL_TERMINAL_PROCESSING))){ local_win_savemode = 0; return; }
+}
+void local_ANSIRestore(void)
+{
+ if(!SetConsoleMode(local_win_stdout,local_win_savemode)){ return; }
+}
+#else
+void local_ANSISetup(void) {}
+void local_ANSIRestore(void) {}
+#endif
+
+// <eof>
@@ -0,0 +1,396 @@
+/*
+ * File: rsha256pl_batch_x64.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * SHA256 of N messages (any length), with intrinsics and Intel SHA Extensions
+ * Multi-buffer edition, pipelined x1 to x4, for many small independent messages
+ *
+ * rsha256_batch() - SHA256 of N messages, result N x 32bytes
+ *
+ * Messages grouped by number of 64bytes blocks (padding included), equal
+ * block count in all lanes. Each lane has its own last 1-2 blocks (rest of
+ * message, padding and length) prepared in a local buffer, other blocks are
+ * read directly from message.
+ *
+ * Requirement: Intel/AMD x64 CPU, with SHA Extensions
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#if defined(__amd64__) || defined(_M_AMD64)
+#include <immintrin.h>
+#endif
+
+#ifdef _WIN32
+#include <intrin.h>
+#endif
+
+#if defined(__amd64__) || defined(_M_AMD64)
+
+//-- load 64bytes block into message, shuffled, save state
+#define BATCH_LOAD(P,src) \
+  MSGTMP0##P = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)((src) + 0)),SHUF_MASK); \
+  MSGTMP1##P = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)((src) + 16)),SHUF_MASK); \
+  MSGTMP2##P = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)((src) + 32)),SHUF_MASK); \
+  MSGTMP3##P = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)((src) + 48)),SHUF_MASK); \
+  SAVE0##P = STATE0##P; \
+  SAVE1##P = STATE1##P;
+
+//-- add saved state to block state
+#define BATCH_ADD(P) \
+  STATE0##P = _mm_add_epi32(STATE0##P,SAVE0##P); \
+  STATE1##P = _mm_add_epi32(STATE1##P,SAVE1##P);
+
+//-- shuffle state back, store 32bytes
+#define BATCH_STORE(P,dst) \
+  STATE0##P = _mm_shuffle_epi32(STATE0##P,0x1B); \
+  STATE1##P = _mm_shuffle_epi32(STATE1##P,0xB1); \
+  MSGV##P = _mm_blend_epi16(STATE0##P,STATE1##P,0xF0); \
+  MSGTMP0##P = _mm_alignr_epi8(STATE1##P,STATE0##P,8); \
+  _mm_storeu_si128((__m128i*)((dst) + 0),_mm_shuffle_epi8(MSGV##P,SHUF_MASK)); \
+  _mm_storeu_si128((__m128i*)((dst) + 16),_mm_shuffle_epi8(MSGTMP0##P,SHUF_MASK));
+
+//-- rounds 0-3, 4-7, 8-11, 12-15
+#define BATCH_RNDS00(P) \
+  MSGV##P = _mm_add_epi32(MSGTMP0##P,_mm_load_si128((const __m128i*)(&K64[0]))); \
+  STATE1##P = _mm_sha256rnds2_epu32(STATE1##P,STATE0##P,MSGV##P); \
+  MSGV##P = _mm_shuffle_epi32(MSGV##P,0x0E); \
+  STATE0##P = _mm_sha256rnds2_epu32(STATE0##P,STATE1##P,MSGV##P);
+
+#define BATCH_RNDS04(P) \
+  MSGV##P = _mm_add_epi32(MSGTMP1##P,_mm_load_si128((const __m128i*)(&K64[4]))); \
+  STATE1##P = _mm_sha256rnds2_epu32(STATE1##P,STATE0##P,MSGV##P); \
+  MSGV##P = _mm_shuffle_epi32(MSGV##P,0x0E); \
+  STATE0##P = _mm_sha256rnds2_epu32(STATE0##P,STATE1##P,MSGV##P); \
+  MSGTMP0##P = _mm_sha256msg1_epu32(MSGTMP0##P,MSGTMP1##P);
+
+#define BATCH_RNDS08(P) \
+  MSGV##P = _mm_add_epi32(MSGTMP2##P,_mm_load_si128((const __m128i*)(&K64[8]))); \
+  STATE1##P = _mm_sha256rnds2_epu32(STATE1##P,STATE0##P,MSGV##P); \
+  MSGV##P = _mm_shuffle_epi32(MSGV##P,0x0E); \
+  STATE0##P = _mm_sha256rnds2_epu32(STATE0##P,STATE1##P,MSGV##P); \
+  MSGTMP1##P = _mm_sha256msg1_epu32(MSGTMP1##P,MSGTMP2##P);
+
+#define BATCH_RNDS12(P) \
+  MSGV##P = _mm_add_epi32(MSGTMP3##P,_mm_load_si128((const __m128i*)(&K64[12]))); \
+  STATE1##P = _mm_sha256rnds2_epu32(STATE1##P,STATE0##P,MSGV##P); \
+  MSGTMP0##P = _mm_add_epi32(MSGTMP0##P,_mm_alignr_epi8(MSGTMP3##P,MSGTMP2##P,4)); \
+  MSGTMP0##P = _mm_sha256msg2_epu32(MSGTMP0##P,MSGTMP3##P); \
+  MSGV##P = _mm_shuffle_epi32(MSGV##P,0x0E); \
+  STATE0##P = _mm_sha256rnds2_epu32(STATE0##P,STATE1##P,MSGV##P); \
+  MSGTMP2##P = _mm_sha256msg1_epu32(MSGTMP2##P,MSGTMP3##P);
+
+//-- rounds 16-19 to 48-51, same as SHA256ROUND in rsha256_fast_x64.cxx
+#define BATCH_RNDS(P,m0,m1,m2,m3,k) \
+  MSGV##P = _mm_add_epi32(MSGTMP##m0##P,_mm_load_si128((const __m128i*)(&K64[k]))); \
+  STATE1##P = _mm_sha256rnds2_epu32(STATE1##P,STATE0##P,MSGV##P); \
+  MSGTMP##m1##P = _mm_add_epi32(MSGTMP##m1##P,_mm_alignr_epi8(MSGTMP##m0##P,MSGTMP##m3##P,4)); \
+  MSGTMP##m1##P = _mm_sha256msg2_epu32(MSGTMP##m1##P,MSGTMP##m0##P); \
+  MSGV##P = _mm_shuffle_epi32(MSGV##P,0x0E); \
+  STATE0##P = _mm_sha256rnds2_epu32(STATE0##P,STATE1##P,MSGV##P); \
+  MSGTMP##m3##P = _mm_sha256msg1_epu32(MSGTMP##m3##P,MSGTMP##m0##P);
+
+//-- rounds 52-55, 56-59
+#define BATCH_RNDSL(P,m0,m1,m2,k) \
+  MSGV##P = _mm_add_epi32(MSGTMP##m0##P,_mm_load_si128((const __m128i*)(&K64[k]))); \
+  STATE1##P = _mm_sha256rnds2_epu32(STATE1##P,STATE0##P,MSGV##P); \
+  MSGTMP##m1##P = _mm_add_epi32(MSGTMP##m1##P,_mm_alignr_epi8(MSGTMP##m0##P,MSGTMP##m2##P,4)); \
+  MSGTMP##m1##P = _mm_sha256msg2_epu32(MSGTMP##m1##P,MSGTMP##m0##P); \
+  MSGV##P = _mm_shuffle_epi32(MSGV##P,0x0E); \
+  STATE0##P = _mm_sha256rnds2_epu32(STATE0##P,STATE1##P,MSGV##P);
+
+//-- rounds 60-63
+#define BATCH_RNDS60(P) \
+  MSGV##P = _mm_add_epi32(MSGTMP3##P,_mm_load_si128((const __m128i*)(&K64[60]))); \
+  STATE1##P = _mm_sha256rnds2_epu32(STATE1##P,STATE0##P,MSGV##P); \
+  MSGV##P = _mm_shuffle_epi32(MSGV##P,0x0E); \
+  STATE0##P = _mm_sha256rnds2_epu32(STATE0##P,STATE1##P,MSGV##P);
+
+//-- 64 rounds of 1x block, x1 to x4 (interleaved per 4 rounds)
+#define BATCH_BLOCK_X1 \
+  BATCH_RNDS00(_P1) BATCH_RNDS04(_P1) BATCH_RNDS08(_P1) BATCH_RNDS12(_P1) \
+  BATCH_RNDS(_P1,0,1,2,3,16) BATCH_RNDS(_P1,1,2,3,0,20) BATCH_RNDS(_P1,2,3,0,1,24) BATCH_RNDS(_P1,3,0,1,2,28) \
+  BATCH_RNDS(_P1,0,1,2,3,32) BATCH_RNDS(_P1,1,2,3,0,36) BATCH_RNDS(_P1,2,3,0,1,40) BATCH_RNDS(_P1,3,0,1,2,44) \
+  BATCH_RNDS(_P1,0,1,2,3,48) BATCH_RNDSL(_P1,1,2,0,52) BATCH_RNDSL(_P1,2,3,1,56) BATCH_RNDS60(_P1)
+
+#define BATCH_BLOCK_X2 \
+  BATCH_RNDS00(_P1) BATCH_RNDS00(_P2) BATCH_RNDS04(_P1) BATCH_RNDS04(_P2) \
+  BATCH_RNDS08(_P1) BATCH_RNDS08(_P2) BATCH_RNDS12(_P1) BATCH_RNDS12(_P2) \
+  BATCH_RNDS(_P1,0,1,2,3,16) BATCH_RNDS(_P2,0,1,2,3,16) BATCH_RNDS(_P1,1,2,3,0,20) BATCH_RNDS(_P2,1,2,3,0,20) \
+  BATCH_RNDS(_P1,2,3,0,1,24) BATCH_RNDS(_P2,2,3,0,1,24) BATCH_RNDS(_P1,3,0,1,2,28) BATCH_RNDS(_P2,3,0,1,2,28) \
+  BATCH_RNDS(_P1,0,1,2,3,32) BATCH_RNDS(_P2,0,1,2,3,32) BATCH_RNDS(_P1,1,2,3,0,36) BATCH_RNDS(_P2,1,2,3,0,36) \
+  BATCH_RNDS(_P1,2,3,0,1,40) BATCH_RNDS(_P2,2,3,0,1,40) BATCH_RNDS(_P1,3,0,1,2,44) BATCH_RNDS(_P2,3,0,1,2,44) \
+  BATCH_RNDS(_P1,0,1,2,3,48) BATCH_RNDS(_P2,0,1,2,3,48) BATCH_RNDSL(_P1,1,2,0,52) BATCH_RNDSL(_P2,1,2,0,52) \
+  BATCH_RNDSL(_P1,2,3,1,56) BATCH_RNDSL(_P2,2,3,1,56) BATCH_RNDS60(_P1) BATCH_RNDS60(_P2)
+
+#define BATCH_BLOCK_X3 \
+  BATCH_RNDS00(_P1) BATCH_RNDS00(_P2) BATCH_RNDS00(_P3) \
+  BATCH_RNDS04(_P1) BATCH_RNDS04(_P2) BATCH_RNDS04(_P3) \
+  BATCH_RNDS08(_P1) BATCH_RNDS08(_P2) BATCH_RNDS08(_P3) \
+  BATCH_RNDS12(_P1) BATCH_RNDS12(_P2) BATCH_RNDS12(_P3) \
+  BATCH_RNDS(_P1,0,1,2,3,16) BATCH_RNDS(_P2,0,1,2,3,16) BATCH_RNDS(_P3,0,1,2,3,16) \
+  BATCH_RNDS(_P1,1,2,3,0,20) BATCH_RNDS(_P2,1,2,3,0,20) BATCH_RNDS(_P3,1,2,3,0,20) \
+  BATCH_RNDS(_P1,2,3,0,1,24) BATCH_RNDS(_P2,2,3,0,1,24) BATCH_RNDS(_P3,2,3,0,1,24) \
+  BATCH_RNDS(_P1,3,0,1,2,28) BATCH_RNDS(_P2,3,0,1,2,28) BATCH_RNDS(_P3,3,0,1,2,28) \
+  BATCH_RNDS(_P1,0,1,2,3,32) BATCH_RNDS(_P2,0,1,2,3,32) BATCH_RNDS(_P3,0,1,2,3,32) \
+  BATCH_RNDS(_P1,1,2,3,0,36) BATCH_RNDS(_P2,1,2,3,0,36) BATCH_RNDS(_P3,1,2,3,0,36) \
+  BATCH_RNDS(_P1,2,3,0,1,40) BATCH_RNDS(_P2,2,3,0,1,40) BATCH_RNDS(_P3,2,3,0,1,40) \
+  BATCH_RNDS(_P1,3,0,1,2,44) BATCH_RNDS(_P2,3,0,1,2,44) BATCH_RNDS(_P3,3,0,1,2,44) \
+  BATCH_RNDS(_P1,0,1,2,3,48) BATCH_RNDS(_P2,0,1,2,3,48) BATCH_RNDS(_P3,0,1,2,3,48) \
+  BATCH_RNDSL(_P1,1,2,0,52) BATCH_RNDSL(_P2,1,2,0,52) BATCH_RNDSL(_P3,1,2,0,52) \
+  BATCH_RNDSL(_P1,2,3,1,56) BATCH_RNDSL(_P2,2,3,1,56) BATCH_RNDSL(_P3,2,3,1,56) \
+  BATCH_RNDS60(_P1) BATCH_RNDS60(_P2) BATCH_RNDS60(_P3)
+
+#define BATCH_BLOCK_X4 \
+  BATCH_RNDS00(_P1) BATCH_RNDS00(_P2) BATCH_RNDS00(_P3) BATCH_RNDS00(_P4) \
+  BATCH_RNDS04(_P1) BATCH_RNDS04(_P2) BATCH_RNDS04(_P3) BATCH_RNDS04(_P4) \
+  BATCH_RNDS08(_P1) BATCH_RNDS08(_P2) BATCH_RNDS08(_P3) BATCH_RNDS08(_P4) \
+  BATCH_RNDS12(_P1) BATCH_RNDS12(_P2) BATCH_RNDS12(_P3) BATCH_RNDS12(_P4) \
+  BATCH_RNDS(_P1,0,1,2,3,16) BATCH_RNDS(_P2,0,1,2,3,16) BATCH_RNDS(_P3,0,1,2,3,16) BATCH_RNDS(_P4,0,1,2,3,16) \
+  BATCH_RNDS(_P1,1,2,3,0,20) BATCH_RNDS(_P2,1,2,3,0,20) BATCH_RNDS(_P3,1,2,3,0,20) BATCH_RNDS(_P4,1,2,3,0,20) \
+  BATCH_RNDS(_P1,2,3,0,1,24) BATCH_RNDS(_P2,2,3,0,1,24) BATCH_RNDS(_P3,2,3,0,1,24) BATCH_RNDS(_P4,2,3,0,1,24) \
+  BATCH_RNDS(_P1,3,0,1,2,28) BATCH_RNDS(_P2,3,0,1,2,28) BATCH_RNDS(_P3,3,0,1,2,28) BATCH_RNDS(_P4,3,0,1,2,28) \
+  BATCH_RNDS(_P1,0,1,2,3,32) BATCH_RNDS(_P2,0,1,2,3,32) BATCH_RNDS(_P3,0,1,2,3,32) BATCH_RNDS(_P4,0,1,2,3,32) \
+  BATCH_RNDS(_P1,1,2,3,0,36) BATCH_RNDS(_P2,1,2,3,0,36) BATCH_RNDS(_P3,1,2,3,0,36) BATCH_RNDS(_P4,1,2,3,0,36) \
+  BATCH_RNDS(_P1,2,3,0,1,40) BATCH_RNDS(_P2,2,3,0,1,40) BATCH_RNDS(_P3,2,3,0,1,40) BATCH_RNDS(_P4,2,3,0,1,40) \
+  BATCH_RNDS(_P1,3,0,1,2,44) BATCH_RNDS(_P2,3,0,1,2,44) BATCH_RNDS(_P3,3,0,1,2,44) BATCH_RNDS(_P4,3,0,1,2,44) \
+  BATCH_RNDS(_P1,0,1,2,3,48) BATCH_RNDS(_P2,0,1,2,3,48) BATCH_RNDS(_P3,0,1,2,3,48) BATCH_RNDS(_P4,0,1,2,3,48) \
+  BATCH_RNDSL(_P1,1,2,0,52) BATCH_RNDSL(_P2,1,2,0,52) BATCH_RNDSL(_P3,1,2,0,52) BATCH_RNDSL(_P4,1,2,0,52) \
+  BATCH_RNDSL(_P1,2,3,1,56) BATCH_RNDSL(_P2,2,3,1,56) BATCH_RNDSL(_P3,2,3,1,56) BATCH_RNDSL(_P4,2,3,1,56) \
+  BATCH_RNDS60(_P1) BATCH_RNDS60(_P2) BATCH_RNDS60(_P3) BATCH_RNDS60(_P4)
+
+//-- array of 64x constants for SHA256 rounds
+alignas(64) static const uint32_t K64[64] = {
+  0x428A2F98,0x71374491,0xB5C0FBCF,0xE9B5DBA5,0x3956C25B,0x59F111F1,0x923F82A4,0xAB1C5ED5,
+  0xD807AA98,0x12835B01,0x243185BE,0x550C7DC3,0x72BE5D74,0x80DEB1FE,0x9BDC06A7,0xC19BF174,
+  0xE49B69C1,0xEFBE4786,0x0FC19DC6,0x240CA1CC,0x2DE92C6F,0x4A7484AA,0x5CB0A9DC,0x76F988DA,
+  0x983E5152,0xA831C66D,0xB00327C8,0xBF597FC7,0xC6E00BF3,0xD5A79147,0x06CA6351,0x14292967,
+  0x27B70A85,0x2E1B2138,0x4D2C6DFC,0x53380D13,0x650A7354,0x766A0ABB,0x81C2C92E,0x92722C85,
+  0xA2BFE8A1,0xA81A664B,0xC24B8B70,0xC76C51A3,0xD192E819,0xD6990624,0xF40E3585,0x106AA070,
+  0x19A4C116,0x1E376C08,0x2748774C,0x34B0BCB5,0x391C0CB3,0x4ED8AA4A,0x5B9CCA4F,0x682E6FF3,
+  0x748F82EE,0x78A5636F,0x84C87814,0x8CC70208,0x90BEFFFA,0xA4506CEB,0xBEF9A3F7,0xC67178F2
+ };
+
+//-- 1x message in a lane, last 1-2 blocks (rest of message, padding, length) in tail
+struct local_blane {
+ const uint8_t* msg;
+ uint64_t       full;          //-- number of full 64bytes blocks read from msg
+ uint8_t*       out;
+ alignas(16) uint8_t tail[128];
+};
+
+//-- local_LaneInit() - lane for message, tail with rest of message, padding and length
+static void local_LaneInit(
+local_blane*   lane,
+const uint8_t* msg,
+const uint64_t len,
+uint8_t*       out)
+{
+ const uint64_t rest = len % 64;
+ const uint64_t tail = (rest < 56) ? 1 : 2;
+ const uint64_t bits = len * 8;
+
+ lane->msg = msg;
+ lane->full = len / 64;
+ lane->out = out;
+ memset(lane->tail,0,sizeof(lane->tail));
+ if(rest > 0){ memcpy(lane->tail,&msg[len - rest],rest); }
+ lane->tail[rest] = 0x80;
+ for(uint32_t i = 0; i < 8; ++i){ lane->tail[64 * tail - 1 - i] = (uint8_t)(bits >> (8 * i)); }
+}
+
+//-- local_Block() - 64bytes block b of lane, from message or tail
+static inline const uint8_t* local_Block(
+const local_blane* lane,
+const uint64_t     b)
+{
+ return (b < lane->full) ? &lane->msg[64 * b] : &lane->tail[64 * (b - lane->full)];
+}
+
+//-- local_BlocksX1() - SHA256 of 1x lane, all with num_blocks
+static void local_BlocksX1(
+const local_blane* lane,
+const uint64_t     num_blocks)
+{
+
+ //-- shuffle mask for byte order required by SHA Extensions
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+
+ //-- variables to calculate SHA256 rounds
+ __m128i STATE0_P1; __m128i STATE1_P1; __m128i SAVE0_P1; __m128i SAVE1_P1; __m128i MSGV_P1; __m128i MSGTMP0_P1; __m128i MSGTMP1_P1; __m128i MSGTMP2_P1; __m128i MSGTMP3_P1;
+
+ //-- init state
+ STATE0_P1 = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ STATE1_P1 = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+
+ //-- all blocks, same number in each lane
+ for(uint64_t b = 0; b < num_blocks; ++b){
+   BATCH_LOAD(_P1,local_Block(&lane[0],b));
+   BATCH_BLOCK_X1
+   BATCH_ADD(_P1);
+   }
+
+ BATCH_STORE(_P1,lane[0].out);
+}
+
+//-- local_BlocksX2() - SHA256 of 2x lanes, all with num_blocks, pipelined
+static void local_BlocksX2(
+const local_blane* lane,
+const uint64_t     num_blocks)
+{
+
+ //-- shuffle mask for byte order required by SHA Extensions
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+
+ //-- variables to calculate SHA256 rounds
+ __m128i STATE0_P1; __m128i STATE1_P1; __m128i SAVE0_P1; __m128i SAVE1_P1; __m128i MSGV_P1; __m128i MSGTMP0_P1; __m128i MSGTMP1_P1; __m128i MSGTMP2_P1; __m128i MSGTMP3_P1;
+ __m128i STATE0_P2; __m128i STATE1_P2; __m128i SAVE0_P2; __m128i SAVE1_P2; __m128i MSGV_P2; __m128i MSGTMP0_P2; __m128i MSGTMP1_P2; __m128i MSGTMP2_P2; __m128i MSGTMP3_P2;
+
+ //-- init state
+ STATE0_P1 = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ STATE1_P1 = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+ STATE0_P2 = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ STATE1_P2 = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+
+ //-- all blocks, same number in each lane
+ for(uint64_t b = 0; b < num_blocks; ++b){
+   BATCH_LOAD(_P1,local_Block(&lane[0],b));
+   BATCH_LOAD(_P2,local_Block(&lane[1],b));
+   BATCH_BLOCK_X2
+   BATCH_ADD(_P1);
+   BATCH_ADD(_P2);
+   }
+
+ BATCH_STORE(_P1,lane[0].out);
+ BATCH_STORE(_P2,lane[1].out);
+}
+
+//-- local_BlocksX3() - SHA256 of 3x lanes, all with num_blocks, pipelined
+static void local_BlocksX3(
+const local_blane* lane,
+const uint64_t     num_blocks)
+{
+
+ //-- shuffle mask for byte order required by SHA Extensions
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+
+ //-- variables to calculate SHA256 rounds
+ __m128i STATE0_P1; __m128i STATE1_P1; __m128i SAVE0_P1; __m128i SAVE1_P1; __m128i MSGV_P1; __m128i MSGTMP0_P1; __m128i MSGTMP1_P1; __m128i MSGTMP2_P1; __m128i MSGTMP3_P1;
+ __m128i STATE0_P2; __m128i STATE1_P2; __m128i SAVE0_P2; __m128i SAVE1_P2; __m128i MSGV_P2; __m128i MSGTMP0_P2; __m128i MSGTMP1_P2; __m128i MSGTMP2_P2; __m128i MSGTMP3_P2;
+ __m128i STATE0_P3; __m128i STATE1_P3; __m128i SAVE0_P3; __m128i SAVE1_P3; __m128i MSGV_P3; __m128i MSGTMP0_P3; __m128i MSGTMP1_P3; __m128i MSGTMP2_P3; __m128i MSGTMP3_P3;
+
+ //-- init state
+ STATE0_P1 = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ STATE1_P1 = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+ STATE0_P2 = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ STATE1_P2 = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+ STATE0_P3 = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ STATE1_P3 = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+
+ //-- all blocks, same number in each lane
+ for(uint64_t b = 0; b < num_blocks; ++b){
+   BATCH_LOAD(_P1,local_Block(&lane[0],b));
+   BATCH_LOAD(_P2,local_Block(&lane[1],b));
+   BATCH_LOAD(_P3,local_Block(&lane[2],b));
+   BATCH_BLOCK_X3
+   BATCH_ADD(_P1);
+   BATCH_ADD(_P2);
+   BATCH_ADD(_P3);
+   }
+
+ BATCH_STORE(_P1,lane[0].out);
+ BATCH_STORE(_P2,lane[1].out);
+ BATCH_STORE(_P3,lane[2].out);
+}
+
+//-- local_BlocksX4() - SHA256 of 4x lanes, all with num_blocks, pipelined
+static void local_BlocksX4(
+const local_blane* lane,
+const uint64_t     num_blocks)
+{
+
+ //-- shuffle mask for byte order required by SHA Extensions
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+
+ //-- variables to calculate SHA256 rounds
+ __m128i STATE0_P1; __m128i STATE1_P1; __m128i SAVE0_P1; __m128i SAVE1_P1; __m128i MSGV_P1; __m128i MSGTMP0_P1; __m128i MSGTMP1_P1; __m128i MSGTMP2_P1; __m128i MSGTMP3_P1;
+ __m128i STATE0_P2; __m128i STATE1_P2; __m128i SAVE0_P2; __m128i SAVE1_P2; __m128i MSGV_P2; __m128i MSGTMP0_P2; __m128i MSGTMP1_P2; __m128i MSGTMP2_P2; __m128i MSGTMP3_P2;
+ __m128i STATE0_P3; __m128i STATE1_P3; __m128i SAVE0_P3; __m128i SAVE1_P3; __m128i MSGV_P3; __m128i MSGTMP0_P3; __m128i MSGTMP1_P3; __m128i MSGTMP2_P3; __m128i MSGTMP3_P3;
+ __m128i STATE0_P4; __m128i STATE1_P4; __m128i SAVE0_P4; __m128i SAVE1_P4; __m128i MSGV_P4; __m128i MSGTMP0_P4; __m128i MSGTMP1_P4; __m128i MSGTMP2_P4; __m128i MSGTMP3_P4;
+
+ //-- init state
+ STATE0_P1 = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ STATE1_P1 = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+ STATE0_P2 = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ STATE1_P2 = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+ STATE0_P3 = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ STATE1_P3 = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+ STATE0_P4 = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ STATE1_P4 = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+
+ //-- all blocks, same number in each lane
+ for(uint64_t b = 0; b < num_blocks; ++b){
+   BATCH_LOAD(_P1,local_Block(&lane[0],b));
+   BATCH_LOAD(_P2,local_Block(&lane[1],b));
+   BATCH_LOAD(_P3,local_Block(&lane[2],b));
+   BATCH_LOAD(_P4,local_Block(&lane[3],b));
+   BATCH_BLOCK_X4
+   BATCH_ADD(_P1);
+   BATCH_ADD(_P2);
+   BATCH_ADD(_P3);
+   BATCH_ADD(_P4);
+   }
+
+ BATCH_STORE(_P1,lane[0].out);
+ BATCH_STORE(_P2,lane[1].out);
+ BATCH_STORE(_P3,lane[2].out);
+ BATCH_STORE(_P4,lane[3].out);
+}
+
+void rsha256_batch(             //-- no return value, results to *out
+uint8_t*              out,      //-- output num_msgs x 32bytes SHA256 values, same order as *msgs
+const uint8_t* const* msgs,     //-- input num_msgs pointers to messages
+const uint64_t*       lens,     //-- input num_msgs lengths of messages, bytes
+const uint32_t        num_msgs, //-- number of messages to SHA256
+const uint32_t        lanes)    //-- messages pipelined per core, 1 to 4, 0 = default (x2)
+{
+ static void (*const blocks_xn[4])(const local_blane*,const uint64_t) = {
+   &local_BlocksX1,&local_BlocksX2,&local_BlocksX3,&local_BlocksX4
+   };
+ const uint32_t width = (lanes == 0) ? 2 : std::min<uint32_t>(lanes,4);
+
+ //-- messages ordered by number of blocks (padding included), equal number in each lane
+ std::vector<std::pair<uint64_t,uint32_t>> order(num_msgs);
+ for(uint32_t i = 0; i < num_msgs; ++i){ order[i] = std::make_pair((lens[i] + 9 + 63) / 64,i); }
+ std::sort(order.begin(),order.end());
+
+ local_blane lane[4];
+ uint32_t i = 0;
+ while(i < num_msgs){
+   const uint64_t num_blocks = order[i].first;
+   uint32_t used = 0;
+   while(used < width && i + used < num_msgs && order[i + used].first == num_blocks){
+     const uint32_t m = order[i + used].second;
+     local_LaneInit(&lane[used],msgs[m],lens[m],&out[32 * (uint64_t)m]);
+     ++used;
+     }
+   blocks_xn[used - 1](lane,num_blocks);
+   i += used;
+   }
+}
+
+#endif
+
+// <eof>
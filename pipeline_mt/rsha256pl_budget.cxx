@@ -0,0 +1,119 @@
+/*
+ * File: rsha256pl_budget.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * CPU budget of process, for sizing verify engine (rsha256pl_verify.cxx)
+ *
+ * Logical CPUs process may run on (sched_getaffinity), and CPU quota of
+ * cgroup v2 (cpu.max, all levels up to root). In containers, threads by
+ * hardware_concurrency() leads to CFS throttling, and bad latency.
+ *
+ * Budget not a whole number of CPUs, or a fraction asked for, is given
+ * as duty cycle per thread. Engine sleeps at chunk boundaries to match.
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "rsha256pl_verify.h"
+
+#if defined(__linux__)
+
+//-- local_CgroupPath() - cgroup v2 path of process ("0::/path"), empty if not found
+static std::string local_CgroupPath()
+{
+ std::string path;
+ char line[4096];
+ FILE* file = fopen("/proc/self/cgroup","r");
+ if(file == NULL) return path;
+ while(fgets(line,sizeof(line),file) != NULL){
+   if(strncmp(line,"0::",3)) continue;
+   path = &line[3];
+   while(!path.empty() && (path.back() == '\n' || path.back() == '\r')) path.pop_back();
+   break;
+   }
+ fclose(file);
+ return path;
+}
+
+//-- local_CgroupQuota() - CPUs of cpu.max in cgroup dir, 0.0 if no limit ("max")
+static double local_CgroupQuota(const std::string& dir)
+{
+ char quota[32];
+ unsigned long long period = 0;
+ double cpus = 0.0;
+ FILE* file = fopen((dir + "/cpu.max").c_str(),"r");
+ if(file == NULL) return 0.0;
+ if(fscanf(file,"%31s %llu",quota,&period) == 2 && strcmp(quota,"max") && period > 0){
+   cpus = strtod(quota,NULL) / (double)period;
+   }
+ fclose(file);
+ return cpus;
+}
+
+#endif
+
+//-- rsha256_cpu_budget() - CPUs available to process, threads and duty cycle to match
+void rsha256_cpu_budget(
+rsha256_cpubudget* budget,
+const double       fraction)
+{
+ budget->cpus = std::thread::hardware_concurrency();
+ if(budget->cpus < 1) budget->cpus = 1;
+ budget->cpus_affinity = budget->cpus;
+ budget->cpus_quota = 0.0;
+
+#if defined(__linux__)
+ //-- logical CPUs in affinity mask
+ cpu_set_t cpuset;
+ CPU_ZERO(&cpuset);
+ if(sched_getaffinity(0,sizeof(cpuset),&cpuset) == 0){
+   int count = CPU_COUNT(&cpuset);
+   if(count > 0) budget->cpus_affinity = (uint32_t)count;
+   }
+
+ //-- lowest cpu.max quota, from cgroup of process up to root
+ std::string path = local_CgroupPath();
+ if(!path.empty()){
+   for(;;){
+     double cpus = local_CgroupQuota("/sys/fs/cgroup" + ((path == "/") ? std::string() : path));
+     if(cpus > 0.0 && (budget->cpus_quota <= 0.0 || cpus < budget->cpus_quota)) budget->cpus_quota = cpus;
+     if(path == "/" || path.empty()) break;
+     size_t slash = path.find_last_of('/');
+     path = (slash == 0 || slash == std::string::npos) ? "/" : path.substr(0,slash);
+     }
+   }
+#endif
+
+ //-- budget, min of affinity and quota, times fraction
+ double cpus = (double)budget->cpus_affinity;
+ if(budget->cpus_quota > 0.0 && budget->cpus_quota < cpus) cpus = budget->cpus_quota;
+ if(fraction > 0.0 && fraction < 1.0) cpus *= fraction;
+ if(cpus < 0.01) cpus = 0.01;
+ budget->cpus_budget = cpus;
+
+ //-- whole threads, last part of CPU as duty cycle spread over all
+ budget->threads = (uint32_t)cpus;
+ if((double)budget->threads < cpus - 0.01) ++budget->threads;
+ if(budget->threads < 1) budget->threads = 1;
+ budget->duty = cpus / (double)budget->threads;
+ if(budget->duty > 0.99) budget->duty = 1.0;
+}
+
+// <eof>
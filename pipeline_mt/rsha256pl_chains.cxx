@@ -0,0 +1,161 @@
+/*
+ * File: rsha256pl_chains.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Bulk of independent recursive SHA256 chains, pipelined, multithreaded
+ * For simulations and test vectors, millions of short chains in 1x call
+ *
+ * rsha256_chains() - M chains in place, same or per chain iterations
+ *
+ * Hashes are 1x array of 32bytes values, same layout as rsha256_fast_xN()
+ * takes for its lanes. Threads take blocks of chains from a shared counter.
+ * Same iterations for all chains, lanes run in place on array, no copy.
+ * Iterations per chain, lanes are refilled as chains finish, run to next
+ * chain done, 32bytes copy in/out per chain.
+ *
+ * Requirement: rsha256pl_fast_x64.cxx or rsha256pl_fast_arm.cxx, rsha256pl_budget.cxx
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "rsha256pl_verify.h"
+
+//-- number of lanes (pipelined edition) per thread, _x2 best in most cases (RESULTS.md)
+#ifndef RSHA256PL_CHAINS_LANES
+#define RSHA256PL_CHAINS_LANES 2
+#endif
+
+//-- chains per block taken by a thread from shared counter
+#ifndef RSHA256PL_CHAINS_BLOCK
+#define RSHA256PL_CHAINS_BLOCK 256
+#endif
+
+//-- pipelined editions, index by number of lanes - 1
+static void (* const local_fastxn[4])(uint8_t*,const uint64_t) = {
+ &rsha256_fast_x1, &rsha256_fast_x2, &rsha256_fast_x3, &rsha256_fast_x4 };
+
+//-- local_ChainsSame() - block of chains with same iterations, lanes in place on array
+static void local_ChainsSame(
+uint8_t*       hashes,
+const uint64_t num_chains,
+const uint64_t num_iters,
+const uint32_t lanes)
+{
+ uint64_t i = 0;
+ for(; i + lanes <= num_chains; i += lanes){ local_fastxn[lanes - 1](&hashes[32 * i],num_iters); }
+ if(i < num_chains){ local_fastxn[num_chains - i - 1](&hashes[32 * i],num_iters); }
+}
+
+//-- local_ChainsEach() - block of chains with own iterations, lanes refilled as chains finish
+static void local_ChainsEach(
+uint8_t*        hashes,
+const uint64_t* iters,
+const uint64_t  num_chains,
+const uint32_t  lanes)
+{
+ alignas(64) uint8_t lanehash[32 * 4];
+ uint64_t lanechain[4];
+ uint64_t laneleft[4];
+ uint32_t used = 0;
+ uint64_t next = 0;
+
+ for(;;){
+
+   //-- fill empty lanes, chains with 0 iterations are done as is
+   while(used < lanes && next < num_chains){
+     if(iters[next] > 0){
+       memcpy(&lanehash[32 * used],&hashes[32 * next],32);
+       lanechain[used] = next;
+       laneleft[used] = iters[next];
+       ++used;
+       }
+     ++next;
+     }
+   if(used == 0){ break; }
+
+   //-- run all lanes to first chain done
+   uint64_t run = laneleft[0];
+   for(uint32_t i = 1; i < used; ++i){ if(laneleft[i] < run) run = laneleft[i]; }
+   local_fastxn[used - 1](lanehash,run);
+
+   //-- chains done out, last lane moved into hole
+   for(uint32_t i = 0; i < used;){
+     laneleft[i] -= run;
+     if(laneleft[i] == 0){
+       memcpy(&hashes[32 * lanechain[i]],&lanehash[32 * i],32);
+       --used;
+       if(i < used){
+         memcpy(&lanehash[32 * i],&lanehash[32 * used],32);
+         lanechain[i] = lanechain[used];
+         laneleft[i] = laneleft[used];
+         }
+       continue;
+       }
+     ++i;
+     }
+   }
+}
+
+//-- local_ChainsWorker() - blocks of chains from shared counter, until all taken
+static void local_ChainsWorker(
+uint8_t*               hashes,
+const uint64_t*        iters,
+const uint64_t         num_iters,
+const uint64_t         num_chains,
+const uint32_t         lanes,
+std::atomic<uint64_t>* counter)
+{
+ for(;;){
+   const uint64_t first = counter->fetch_add(RSHA256PL_CHAINS_BLOCK);
+   if(first >= num_chains){ break; }
+   const uint64_t count = (num_chains - first < RSHA256PL_CHAINS_BLOCK) ? num_chains - first : RSHA256PL_CHAINS_BLOCK;
+   if(iters == NULL){ local_ChainsSame(&hashes[32 * first],count,num_iters,lanes); }
+   else             { local_ChainsEach(&hashes[32 * first],&iters[first],count,lanes); }
+   }
+}
+
+//-- rsha256_chains() - M independent chains in place, lanes per thread, threads by CPU budget if 0
+void rsha256_chains(
+uint8_t*        hashes,
+const uint64_t* iters,
+const uint64_t  num_iters,
+const uint64_t  num_chains,
+const uint32_t  lanes,
+const uint32_t  threads)
+{
+ if(num_chains == 0) return;
+ uint32_t width = (lanes > 0) ? lanes : RSHA256PL_CHAINS_LANES;
+ if(width > 4) width = 4;
+
+ //-- no more threads than blocks of chains
+ uint32_t nthreads = threads;
+ if(nthreads == 0){
+   rsha256_cpubudget budget;
+   rsha256_cpu_budget(&budget,1.0);
+   nthreads = budget.threads;
+   }
+ const uint64_t nblocks = (num_chains + RSHA256PL_CHAINS_BLOCK - 1) / RSHA256PL_CHAINS_BLOCK;
+ if(nthreads > nblocks) nthreads = (uint32_t)nblocks;
+ if(nthreads < 1) nthreads = 1;
+
+ //-- caller thread is 1x of workers
+ std::atomic<uint64_t> counter(0);
+ std::vector<std::thread> workers;
+ for(uint32_t t = 1; t < nthreads; ++t){ workers.emplace_back(local_ChainsWorker,hashes,iters,num_iters,num_chains,width,&counter); }
+ local_ChainsWorker(hashes,iters,num_iters,num_chains,width,&counter);
+ for(std::thread& worker : workers){ worker.join(); }
+}
+
+// <eof>
@@ -0,0 +1,156 @@
+/*
+ * File: rsha256pl_locate.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Locate first bad iteration in a failing VDF segment, multithreaded
+ *
+ * rsha256_locate_record() - Recompute segment, record sub-checkpoints
+ * rsha256_locate()        - k-ary bisection, k sub-ranges verified in parallel
+ *
+ * Creator hash/data of segment at an iteration is given by callback. Only
+ * iterations creator has (sub-checkpoints, trace) are used, bisection
+ * stops at finest sub-range creator can give. 1st sub-range where hash at
+ * end differs from SHA256 iterations of hash at start is bad, all before
+ * are ok, so first bad iteration is inside it.
+ *
+ * Unstable overclock of a TimeLord, 1x bad iteration in billions, found by
+ * log(k) rounds of all cores, instead of 1x core recompute of all.
+ *
+ * Requirement: rsha256pl_verify.cxx, rsha256pl_budget.cxx
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+#include "rsha256pl_verify.h"
+
+//-- rsha256_locate_record() - recompute segment from start, hash/data every sub_iters (last at iters)
+uint64_t rsha256_locate_record(
+uint8_t*       sub_hashes,
+const uint8_t* start,
+const uint64_t iters,
+const uint64_t sub_iters)
+{
+ if(sub_iters == 0) return 0;
+ alignas(64) uint8_t hash[32];
+ uint64_t done = 0;
+ uint64_t num = 0;
+ memcpy(hash,start,32);
+
+ while(done < iters){
+   uint64_t run = (iters - done < sub_iters) ? iters - done : sub_iters;
+   rsha256_fast_x1(hash,run);
+   memcpy(&sub_hashes[32 * num],hash,32);
+   done += run;
+   ++num;
+   }
+ return num;
+}
+
+//-- rsha256_locate_subcps() - callback for array of sub-checkpoints (rsha256_subcps), largest at or below iter
+uint64_t rsha256_locate_subcps(
+void*          ctx,
+const uint64_t iter,
+uint8_t*       hash)
+{
+ const rsha256_subcps* subcps = (const rsha256_subcps*)ctx;
+ if(subcps->sub_iters == 0) return 0;
+ uint64_t idx = iter / subcps->sub_iters;
+ if(idx > subcps->num) idx = subcps->num;
+ if(idx == 0) return 0;
+ memcpy(hash,&subcps->hashes[32 * (idx - 1)],32);
+ return idx * subcps->sub_iters;
+}
+
+//-- rsha256_locate() - k-ary bisection of segment, sub-ranges verified in parallel, return true if bad
+bool rsha256_locate(
+uint64_t*       good_iter,
+uint64_t*       bad_iter,
+const uint8_t*  start,
+const uint8_t*  end,
+const uint64_t  iters,
+rsha256_locfunc func,
+void*           ctx,
+const uint32_t  ways,
+const uint32_t  threads)
+{
+ //-- k sub-ranges per round, default 1x per lane of _x2 on all threads
+ uint32_t k = ways;
+ if(k == 0){
+   uint32_t nthreads = threads;
+   if(nthreads == 0){
+     rsha256_cpubudget budget;
+     rsha256_cpu_budget(&budget,1.0);
+     nthreads = budget.threads;
+     }
+   k = 2 * nthreads;
+   }
+ if(k < 2) k = 2;
+
+ std::vector<uint8_t> hashes(32 * (k + 1));
+ std::vector<uint64_t> points(k + 1);
+ std::vector<rsha256_vseg> segs(k);
+
+ //-- range, hash at lo known ok, hash at hi known bad (after 1st round)
+ uint64_t lo = 0;
+ uint64_t hi = iters;
+ uint8_t lohash[32];
+ uint8_t hihash[32];
+ memcpy(lohash,start,32);
+ memcpy(hihash,end,32);
+ bool known = false;
+
+ while(hi - lo > 1 || !known){
+
+   //-- creator hash/data at k-1 points inside range, only iterations creator has
+   uint32_t num = 0;
+   uint64_t span = hi - lo;
+   memcpy(&hashes[0],lohash,32);
+   points[0] = lo;
+   for(uint32_t j = 1; j < k && func != NULL; ++j){
+     uint64_t want = lo + (span / k) * j + ((span % k) * j) / k;
+     uint64_t got = func(ctx,want,&hashes[32 * (num + 1)]);
+     if(got > points[num] && got < hi){ points[++num] = got; }
+     }
+   ++num;
+   points[num] = hi;
+   memcpy(&hashes[32 * num],hihash,32);
+
+   //-- no finer iterations from creator, stop at known range
+   if(num == 1 && known) break;
+
+   for(uint32_t j = 0; j < num; ++j){
+     segs[j].start = &hashes[32 * j];
+     segs[j].end = &hashes[32 * (j + 1)];
+     segs[j].iters = points[j + 1] - points[j];
+     }
+
+   //-- 1st bad sub-range, all ok only possible in 1st round (segment not bad)
+   uint32_t fail = rsha256_verify_segs(segs.data(),num,threads,NULL);
+   if(fail == num){
+     if(!known) return false;
+     break;
+     }
+
+   lo = points[fail];
+   hi = points[fail + 1];
+   memcpy(lohash,&hashes[32 * fail],32);
+   memcpy(hihash,&hashes[32 * (fail + 1)],32);
+   known = true;
+   }
+
+ if(good_iter != NULL) *good_iter = lo;
+ if(bad_iter != NULL) *bad_iter = hi;
+ return true;
+}
+
+// <eof>
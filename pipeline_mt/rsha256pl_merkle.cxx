@@ -0,0 +1,391 @@
+/*
+ * File: rsha256pl_merkle.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Merkle commitment over VDF checkpoints, with deterministic spot-check verify
+ *
+ * Creator builds Merkle root over all checkpoint hashes. Verifier derives
+ * pseudo-random subset of segments from root (Fiat-Shamir style), and
+ * verifies only those segments, plus Merkle paths of their checkpoints.
+ * Full verify (rsha256_verify()) of same checkpoints still possible later.
+ *
+ * Tree: leaves are checkpoint hashes, node is SHA256(left||right),
+ * odd node at end of a level is moved up unchanged.
+ *
+ * Selection: unbiased draws of segment index, bitmap of drawn segments.
+ * More than half of segments selected, draws the ones left out instead.
+ * All segments selected, no draws.
+ *
+ * Stream: same root from leaves added as they come (rsha256_mstream_*()),
+ * each level keeps a buffer of nodes, full buffer is hashed in 1x batch
+ * through multi-buffer rsha256_pair(), result goes to level above.
+ *
+ * Requirement: rsha256pl_pair_*.cxx, rsha256pl_verify.cxx
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "rsha256pl_verify.h"
+
+//-- pairs per level hashed in 1x batch by streaming Merkle root, buffer of 2x nodes per level
+#ifndef RSHA256PL_MSTREAM_BATCH
+#define RSHA256PL_MSTREAM_BATCH 256
+#endif
+
+//-- rsha256_merkle_size() - number of nodes in tree with num_leaves, all levels
+uint64_t rsha256_merkle_size(
+const uint32_t num_leaves)
+{
+ uint64_t nodes = 0;
+ uint64_t count = num_leaves;
+ while(count > 1){ nodes += count; count = (count + 1) / 2; }
+ return nodes + count;
+}
+
+//-- rsha256_merkle_build() - all levels into *tree, leaves first, root last
+void rsha256_merkle_build(
+uint8_t*       tree,
+const uint8_t* leaves,
+const uint32_t num_leaves)
+{
+ if(num_leaves == 0) return;
+ memcpy(tree,leaves,(size_t)num_leaves * 32);
+
+ uint8_t* level = tree;
+ uint64_t count = num_leaves;
+ while(count > 1){
+   uint8_t* up = level + count * 32;
+   rsha256_pair(up,level,count / 2);
+   if(count & 1){ memcpy(&up[32 * (count / 2)],&level[32 * (count - 1)],32); }
+   level = up;
+   count = (count + 1) / 2;
+   }
+}
+
+//-- rsha256_merkle_root() - root only, levels built in place of 1x copy of leaves
+void rsha256_merkle_root(
+uint8_t*       root,
+const uint8_t* leaves,
+const uint32_t num_leaves)
+{
+ if(num_leaves == 0){ memset(root,0,32); return; }
+ std::vector<uint8_t> level(leaves,leaves + (size_t)num_leaves * 32);
+
+ uint64_t count = num_leaves;
+ while(count > 1){
+   rsha256_pair(level.data(),level.data(),count / 2);
+   if(count & 1){ memmove(&level[32 * (count / 2)],&level[32 * (count - 1)],32); }
+   count = (count + 1) / 2;
+   }
+ memcpy(root,level.data(),32);
+}
+
+//-- 1x level of streaming Merkle root, nodes not yet hashed into level above
+struct local_mlevel {
+ std::vector<uint8_t> nodes;   //-- 2x RSHA256PL_MSTREAM_BATCH x 32bytes
+ uint64_t             count;
+};
+
+struct rsha256_mstream {
+ std::vector<local_mlevel> levels;
+ uint64_t                  leaves;
+};
+
+//-- local_MStreamPush() - append nodes to level, full buffer hashed in 1x batch to level above
+static void local_MStreamPush(
+rsha256_mstream* stream,
+const size_t     level,
+const uint8_t*   nodes,
+uint64_t         num_nodes)
+{
+ const uint64_t cap = 2 * RSHA256PL_MSTREAM_BATCH;
+ if(level == stream->levels.size()){
+   stream->levels.emplace_back();
+   stream->levels.back().nodes.resize(cap * 32);
+   stream->levels.back().count = 0;
+   }
+
+ while(num_nodes > 0){
+   local_mlevel& lvl = stream->levels[level];
+   const uint64_t take = std::min(cap - lvl.count,num_nodes);
+   memcpy(&lvl.nodes[32 * lvl.count],nodes,(size_t)take * 32);
+   lvl.count += take;
+   nodes += take * 32;
+   num_nodes -= take;
+   if(lvl.count == cap){
+     //-- buffer starts at even index of level, pairs line up with tree
+     uint8_t* full = lvl.nodes.data();
+     rsha256_pair(full,full,RSHA256PL_MSTREAM_BATCH);
+     lvl.count = 0;
+     local_MStreamPush(stream,level + 1,full,RSHA256PL_MSTREAM_BATCH);
+     }
+   }
+}
+
+//-- rsha256_mstream_create() - new stream, no leaves
+rsha256_mstream* rsha256_mstream_create(void)
+{
+ rsha256_mstream* stream = new rsha256_mstream;
+ stream->leaves = 0;
+ return stream;
+}
+
+//-- rsha256_mstream_add() - leaves appended to stream
+void rsha256_mstream_add(
+rsha256_mstream* stream,
+const uint8_t*   leaves,
+const uint64_t   num_leaves)
+{
+ local_MStreamPush(stream,0,leaves,num_leaves);
+ stream->leaves += num_leaves;
+}
+
+//-- rsha256_mstream_root() - rest of each level up to root, return number of leaves, stream is finished
+uint64_t rsha256_mstream_root(
+rsha256_mstream* stream,
+uint8_t*         root)
+{
+ if(stream->leaves == 0){ memset(root,0,32); return 0; }
+
+ for(size_t level = 0;; ++level){
+   local_mlevel& lvl = stream->levels[level];
+   const uint64_t count = lvl.count;
+   if(level + 1 == stream->levels.size() && count == 1){ memcpy(root,lvl.nodes.data(),32); break; }
+
+   uint8_t* rest = lvl.nodes.data();
+   rsha256_pair(rest,rest,count / 2);
+   if(count & 1){ memmove(&rest[32 * (count / 2)],&rest[32 * (count - 1)],32); }
+   lvl.count = 0;
+   local_MStreamPush(stream,level + 1,rest,(count + 1) / 2);
+   }
+ return stream->leaves;
+}
+
+//-- rsha256_mstream_destroy() - free stream
+void rsha256_mstream_destroy(
+rsha256_mstream* stream)
+{
+ delete stream;
+}
+
+//-- rsha256_merkle_path() - sibling hashes from leaf to root, return number of hashes in path
+uint32_t rsha256_merkle_path(
+uint8_t*       path,
+const uint8_t* tree,
+const uint32_t num_leaves,
+const uint32_t index)
+{
+ uint32_t len = 0;
+ uint64_t count = num_leaves;
+ uint64_t pos = index;
+ const uint8_t* level = tree;
+
+ while(count > 1){
+   uint64_t sibling = pos ^ 1;
+   if(sibling < count){ memcpy(&path[32 * len],&level[32 * sibling],32); ++len; }
+   level += count * 32;
+   count = (count + 1) / 2;
+   pos >>= 1;
+   }
+ return len;
+}
+
+//-- rsha256_merkle_check() - return true if leaf at index, with path, leads to root
+bool rsha256_merkle_check(
+const uint8_t* root,
+const uint8_t* leaf,
+const uint32_t num_leaves,
+const uint32_t index,
+const uint8_t* path,
+const uint32_t path_len)
+{
+ if(index >= num_leaves) return false;
+ uint8_t node[64];
+ uint32_t len = 0;
+ uint64_t count = num_leaves;
+ uint64_t pos = index;
+ memcpy(node,leaf,32);
+
+ while(count > 1){
+   uint64_t sibling = pos ^ 1;
+   if(sibling < count){
+     if(len >= path_len) return false;
+     if(pos & 1){ memmove(&node[32],node,32); memcpy(node,&path[32 * len],32); }
+     else       { memcpy(&node[32],&path[32 * len],32); }
+     rsha256_pair(node,node,1);
+     ++len;
+     }
+   count = (count + 1) / 2;
+   pos >>= 1;
+   }
+ return (len == path_len && !memcmp(node,root,32));
+}
+
+//-- local_SpotSeed() - seed of spot-check, bound to root, start hash and parameters
+static void local_SpotSeed(uint8_t* seed,const uint8_t* root,const uint8_t* start_hash,const uint32_t num_cps,const uint64_t cp_iters)
+{
+ uint8_t block[64];
+ memset(block,0,64);
+ memcpy(&block[0],start_hash,32);
+ memcpy(&block[32],"rsha256spot",11);
+ for(uint32_t i = 0; i < 4; ++i){ block[44 + i] = (uint8_t)(num_cps >> (8 * i)); }
+ for(uint32_t i = 0; i < 8; ++i){ block[48 + i] = (uint8_t)(cp_iters >> (8 * i)); }
+ rsha256_pair(&block[32],block,1);
+ memcpy(&block[0],root,32);
+ rsha256_pair(seed,block,1);
+}
+
+//-- draws of spot-check, 4x 64-bit values per SHA256 of seed||counter
+struct local_spotdraw {
+ uint8_t  block[64];
+ uint8_t  draw[32];
+ uint64_t ctr;
+ uint32_t used;
+ };
+
+//-- local_SpotDraw() - next unbiased pseudo-random value 0 to range - 1
+static uint32_t local_SpotDraw(local_spotdraw* sd,const uint32_t range)
+{
+ //-- values below 2^64 mod range rejected, rest is whole multiple of range
+ const uint64_t bias = (0 - (uint64_t)range) % range;
+ for(;;){
+   if(sd->used == 4){
+     for(uint32_t i = 0; i < 8; ++i){ sd->block[32 + i] = (uint8_t)(sd->ctr >> (8 * i)); }
+     rsha256_pair(sd->draw,sd->block,1);
+     ++sd->ctr;
+     sd->used = 0;
+     }
+   uint64_t val = 0;
+   for(uint32_t i = 0; i < 8; ++i){ val |= (uint64_t)sd->draw[8 * sd->used + i] << (8 * i); }
+   ++sd->used;
+   if(val >= bias) return (uint32_t)(val % range);
+   }
+}
+
+//-- rsha256_spot_select() - pseudo-random distinct segments from root, sorted, return number selected
+uint32_t rsha256_spot_select(
+uint32_t*      segs,
+const uint32_t num_spots,
+const uint8_t* root,
+const uint8_t* start_hash,
+const uint32_t num_cps,
+const uint64_t cp_iters)
+{
+ uint32_t want = (num_spots < num_cps) ? num_spots : num_cps;
+
+ //-- all segments, nothing to draw
+ if(want == num_cps){
+   for(uint32_t i = 0; i < want; ++i){ segs[i] = i; }
+   return want;
+   }
+
+ local_spotdraw sd;
+ local_SpotSeed(sd.block,root,start_hash,num_cps,cp_iters);
+ memset(&sd.block[32],0,32);
+ sd.ctr = 0;
+ sd.used = 4;
+
+ //-- membership in bitmap, more than half selected draws segments left out instead (max 2x draws per segment)
+ std::vector<uint64_t> taken((num_cps + 63) / 64,0);
+ const bool sparse = (want <= num_cps / 2);
+ const uint32_t draws = sparse ? want : num_cps - want;
+ uint32_t count = 0;
+ while(count < draws){
+   uint32_t seg = local_SpotDraw(&sd,num_cps);
+   if(taken[seg / 64] & ((uint64_t)1 << (seg % 64))) continue;
+   taken[seg / 64] |= (uint64_t)1 << (seg % 64);
+   if(sparse) segs[count] = seg;
+   ++count;
+   }
+
+ if(sparse){
+   std::sort(segs,segs + count);
+   return count;
+   }
+ count = 0;
+ for(uint32_t seg = 0; seg < num_cps; ++seg){
+   if(!(taken[seg / 64] & ((uint64_t)1 << (seg % 64)))) segs[count++] = seg;
+   }
+ return count;
+}
+
+//-- rsha256_spot_prove() - creator, root of checkpoints and spot proofs of selected segments
+uint32_t rsha256_spot_prove(
+rsha256_spot*  spots,
+const uint32_t num_spots,
+uint8_t*       root,
+const uint8_t* start_hash,
+const uint8_t* cp_hashes,
+const uint32_t num_cps,
+const uint64_t cp_iters)
+{
+ if(num_cps == 0) return 0;
+ std::vector<uint8_t> tree(rsha256_merkle_size(num_cps) * 32);
+ std::vector<uint32_t> segs(num_spots);
+ rsha256_merkle_build(tree.data(),cp_hashes,num_cps);
+ memcpy(root,&tree[tree.size() - 32],32);
+
+ uint32_t count = rsha256_spot_select(segs.data(),num_spots,root,start_hash,num_cps,cp_iters);
+ for(uint32_t i = 0; i < count; ++i){
+   rsha256_spot* spot = &spots[i];
+   spot->seg = segs[i];
+   memcpy(spot->end,&cp_hashes[32 * segs[i]],32);
+   spot->end_len = rsha256_merkle_path(spot->end_path,tree.data(),num_cps,segs[i]);
+   if(segs[i] == 0){
+     memcpy(spot->start,start_hash,32);
+     spot->start_len = 0;
+     }
+   else{
+     memcpy(spot->start,&cp_hashes[32 * (segs[i] - 1)],32);
+     spot->start_len = rsha256_merkle_path(spot->start_path,tree.data(),num_cps,segs[i] - 1);
+     }
+   }
+ return count;
+}
+
+//-- rsha256_spot_verify() - verifier, check selection and Merkle paths, then verify selected segments
+bool rsha256_spot_verify(
+const uint8_t*      root,
+const uint8_t*      start_hash,
+const uint32_t      num_cps,
+const uint64_t      cp_iters,
+const rsha256_spot* spots,
+const uint32_t      num_spots,
+const uint32_t      threads,
+rsha256_vcache*     cache)
+{
+ if(num_cps == 0 || num_spots == 0) return false;
+
+ //-- short chain, rsha256_spot_prove() gave 1x proof per checkpoint
+ const uint32_t want = (num_spots < num_cps) ? num_spots : num_cps;
+ std::vector<uint32_t> segs(want);
+ if(rsha256_spot_select(segs.data(),num_spots,root,start_hash,num_cps,cp_iters) != want) return false;
+
+ std::vector<rsha256_vseg> vsegs(want);
+ for(uint32_t i = 0; i < want; ++i){
+   const rsha256_spot* spot = &spots[i];
+   if(spot->seg != segs[i]) return false;
+   if(spot->start_len > 32 || spot->end_len > 32) return false;
+   if(!rsha256_merkle_check(root,spot->end,num_cps,spot->seg,spot->end_path,spot->end_len)) return false;
+   if(spot->seg == 0){ if(memcmp(spot->start,start_hash,32)) return false; }
+   else if(!rsha256_merkle_check(root,spot->start,num_cps,spot->seg - 1,spot->start_path,spot->start_len)) return false;
+   vsegs[i].start = spot->start;
+   vsegs[i].end = spot->end;
+   vsegs[i].iters = cp_iters;
+   }
+
+ return (rsha256_verify_segs(vsegs.data(),want,threads,cache) == want);
+}
+
+// <eof>
@@ -0,0 +1,409 @@
+/*
+ * File: rsha256pl_pair_x64.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * SHA256 of 64 bytes (left||right pair), with intrinsics and Intel SHA Extensions
+ * Multi-buffer edition, pipelined x1 to x4, for Merkle tree nodes
+ *
+ * rsha256_pair() - SHA256 of N x 64bytes, result N x 32bytes (x2)
+ * rsha256_pair_x1() - Same, 1x pair at a time
+ * rsha256_pair_x2() - Same, 2x pairs at a time, pipelined
+ * rsha256_pair_x3() - Same, 3x pairs at a time, pipelined
+ * rsha256_pair_x4() - Same, 4x pairs at a time, pipelined
+ *
+ * 2nd block of a 64bytes message is only SHA256 padding, same for all
+ * pairs. Its message schedule (W+K) is precomputed, 2nd block is rounds only.
+ *
+ * Requirement: Intel/AMD x64 CPU, with SHA Extensions
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <stdint.h>
+
+#if defined(__amd64__) || defined(_M_AMD64)
+#include <immintrin.h>
+#endif
+
+#ifdef _WIN32
+#include <intrin.h>
+#endif
+
+#if defined(__amd64__) || defined(_M_AMD64)
+
+//-- load 64bytes (1st block) into message, shuffled, init state
+#define PAIR_LOAD(P,src) \
+  MSGTMP0##P = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)((src) + 0)),SHUF_MASK); \
+  MSGTMP1##P = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)((src) + 16)),SHUF_MASK); \
+  MSGTMP2##P = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)((src) + 32)),SHUF_MASK); \
+  MSGTMP3##P = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)((src) + 48)),SHUF_MASK); \
+  STATE0##P = ABEF_INIT; \
+  STATE1##P = CDGH_INIT;
+
+//-- add init state to 1st block state, save for 2nd block (padding, precomputed W+K)
+#define PAIR_NEXT(P) \
+  STATE0##P = _mm_add_epi32(STATE0##P,ABEF_INIT); \
+  STATE1##P = _mm_add_epi32(STATE1##P,CDGH_INIT); \
+  SAVE0##P = STATE0##P; \
+  SAVE1##P = STATE1##P;
+
+//-- add 1st block state to 2nd block state, shuffle state back, store 32bytes
+#define PAIR_STORE(P,dst) \
+  STATE0##P = _mm_add_epi32(STATE0##P,SAVE0##P); \
+  STATE1##P = _mm_add_epi32(STATE1##P,SAVE1##P); \
+  STATE0##P = _mm_shuffle_epi32(STATE0##P,0x1B); \
+  STATE1##P = _mm_shuffle_epi32(STATE1##P,0xB1); \
+  MSGV##P = _mm_blend_epi16(STATE0##P,STATE1##P,0xF0); \
+  MSGTMP0##P = _mm_alignr_epi8(STATE1##P,STATE0##P,8); \
+  _mm_storeu_si128((__m128i*)((dst) + 0),_mm_shuffle_epi8(MSGV##P,SHUF_MASK)); \
+  _mm_storeu_si128((__m128i*)((dst) + 16),_mm_shuffle_epi8(MSGTMP0##P,SHUF_MASK));
+
+//-- rounds 0-3, 4-7, 8-11, 12-15
+#define PAIR_RNDS00(P) \
+  MSGV##P = _mm_add_epi32(MSGTMP0##P,_mm_load_si128((const __m128i*)(&K64[0]))); \
+  STATE1##P = _mm_sha256rnds2_epu32(STATE1##P,STATE0##P,MSGV##P); \
+  MSGV##P = _mm_shuffle_epi32(MSGV##P,0x0E); \
+  STATE0##P = _mm_sha256rnds2_epu32(STATE0##P,STATE1##P,MSGV##P);
+
+#define PAIR_RNDS04(P) \
+  MSGV##P = _mm_add_epi32(MSGTMP1##P,_mm_load_si128((const __m128i*)(&K64[4]))); \
+  STATE1##P = _mm_sha256rnds2_epu32(STATE1##P,STATE0##P,MSGV##P); \
+  MSGV##P = _mm_shuffle_epi32(MSGV##P,0x0E); \
+  STATE0##P = _mm_sha256rnds2_epu32(STATE0##P,STATE1##P,MSGV##P); \
+  MSGTMP0##P = _mm_sha256msg1_epu32(MSGTMP0##P,MSGTMP1##P);
+
+#define PAIR_RNDS08(P) \
+  MSGV##P = _mm_add_epi32(MSGTMP2##P,_mm_load_si128((const __m128i*)(&K64[8]))); \
+  STATE1##P = _mm_sha256rnds2_epu32(STATE1##P,STATE0##P,MSGV##P); \
+  MSGV##P = _mm_shuffle_epi32(MSGV##P,0x0E); \
+  STATE0##P = _mm_sha256rnds2_epu32(STATE0##P,STATE1##P,MSGV##P); \
+  MSGTMP1##P = _mm_sha256msg1_epu32(MSGTMP1##P,MSGTMP2##P);
+
+#define PAIR_RNDS12(P) \
+  MSGV##P = _mm_add_epi32(MSGTMP3##P,_mm_load_si128((const __m128i*)(&K64[12]))); \
+  STATE1##P = _mm_sha256rnds2_epu32(STATE1##P,STATE0##P,MSGV##P); \
+  MSGTMP0##P = _mm_add_epi32(MSGTMP0##P,_mm_alignr_epi8(MSGTMP3##P,MSGTMP2##P,4)); \
+  MSGTMP0##P = _mm_sha256msg2_epu32(MSGTMP0##P,MSGTMP3##P); \
+  MSGV##P = _mm_shuffle_epi32(MSGV##P,0x0E); \
+  STATE0##P = _mm_sha256rnds2_epu32(STATE0##P,STATE1##P,MSGV##P); \
+  MSGTMP2##P = _mm_sha256msg1_epu32(MSGTMP2##P,MSGTMP3##P);
+
+//-- rounds 16-19 to 48-51, same as SHA256ROUND in rsha256_fast_x64.cxx
+#define PAIR_RNDS(P,m0,m1,m2,m3,k) \
+  MSGV##P = _mm_add_epi32(MSGTMP##m0##P,_mm_load_si128((const __m128i*)(&K64[k]))); \
+  STATE1##P = _mm_sha256rnds2_epu32(STATE1##P,STATE0##P,MSGV##P); \
+  MSGTMP##m1##P = _mm_add_epi32(MSGTMP##m1##P,_mm_alignr_epi8(MSGTMP##m0##P,MSGTMP##m3##P,4)); \
+  MSGTMP##m1##P = _mm_sha256msg2_epu32(MSGTMP##m1##P,MSGTMP##m0##P); \
+  MSGV##P = _mm_shuffle_epi32(MSGV##P,0x0E); \
+  STATE0##P = _mm_sha256rnds2_epu32(STATE0##P,STATE1##P,MSGV##P); \
+  MSGTMP##m3##P = _mm_sha256msg1_epu32(MSGTMP##m3##P,MSGTMP##m0##P);
+
+//-- rounds 52-55, 56-59
+#define PAIR_RNDSL(P,m0,m1,m2,k) \
+  MSGV##P = _mm_add_epi32(MSGTMP##m0##P,_mm_load_si128((const __m128i*)(&K64[k]))); \
+  STATE1##P = _mm_sha256rnds2_epu32(STATE1##P,STATE0##P,MSGV##P); \
+  MSGTMP##m1##P = _mm_add_epi32(MSGTMP##m1##P,_mm_alignr_epi8(MSGTMP##m0##P,MSGTMP##m2##P,4)); \
+  MSGTMP##m1##P = _mm_sha256msg2_epu32(MSGTMP##m1##P,MSGTMP##m0##P); \
+  MSGV##P = _mm_shuffle_epi32(MSGV##P,0x0E); \
+  STATE0##P = _mm_sha256rnds2_epu32(STATE0##P,STATE1##P,MSGV##P);
+
+//-- rounds 60-63
+#define PAIR_RNDS60(P) \
+  MSGV##P = _mm_add_epi32(MSGTMP3##P,_mm_load_si128((const __m128i*)(&K64[60]))); \
+  STATE1##P = _mm_sha256rnds2_epu32(STATE1##P,STATE0##P,MSGV##P); \
+  MSGV##P = _mm_shuffle_epi32(MSGV##P,0x0E); \
+  STATE0##P = _mm_sha256rnds2_epu32(STATE0##P,STATE1##P,MSGV##P);
+
+//-- rounds of padding block, W+K from precomputed array
+#define PAIR_RNDSW(P,k) \
+  MSGV##P = _mm_load_si128((const __m128i*)(&WK2[k])); \
+  STATE1##P = _mm_sha256rnds2_epu32(STATE1##P,STATE0##P,MSGV##P); \
+  MSGV##P = _mm_shuffle_epi32(MSGV##P,0x0E); \
+  STATE0##P = _mm_sha256rnds2_epu32(STATE0##P,STATE1##P,MSGV##P);
+
+//-- 64 rounds of 1x block, x1 to x4 (interleaved per 4 rounds)
+#define PAIR_BLOCK_X1 \
+  PAIR_RNDS00(_P1) PAIR_RNDS04(_P1) PAIR_RNDS08(_P1) PAIR_RNDS12(_P1) \
+  PAIR_RNDS(_P1,0,1,2,3,16) PAIR_RNDS(_P1,1,2,3,0,20) PAIR_RNDS(_P1,2,3,0,1,24) PAIR_RNDS(_P1,3,0,1,2,28) \
+  PAIR_RNDS(_P1,0,1,2,3,32) PAIR_RNDS(_P1,1,2,3,0,36) PAIR_RNDS(_P1,2,3,0,1,40) PAIR_RNDS(_P1,3,0,1,2,44) \
+  PAIR_RNDS(_P1,0,1,2,3,48) PAIR_RNDSL(_P1,1,2,0,52) PAIR_RNDSL(_P1,2,3,1,56) PAIR_RNDS60(_P1)
+
+#define PAIR_BLOCK_X2 \
+  PAIR_RNDS00(_P1) PAIR_RNDS00(_P2) PAIR_RNDS04(_P1) PAIR_RNDS04(_P2) \
+  PAIR_RNDS08(_P1) PAIR_RNDS08(_P2) PAIR_RNDS12(_P1) PAIR_RNDS12(_P2) \
+  PAIR_RNDS(_P1,0,1,2,3,16) PAIR_RNDS(_P2,0,1,2,3,16) PAIR_RNDS(_P1,1,2,3,0,20) PAIR_RNDS(_P2,1,2,3,0,20) \
+  PAIR_RNDS(_P1,2,3,0,1,24) PAIR_RNDS(_P2,2,3,0,1,24) PAIR_RNDS(_P1,3,0,1,2,28) PAIR_RNDS(_P2,3,0,1,2,28) \
+  PAIR_RNDS(_P1,0,1,2,3,32) PAIR_RNDS(_P2,0,1,2,3,32) PAIR_RNDS(_P1,1,2,3,0,36) PAIR_RNDS(_P2,1,2,3,0,36) \
+  PAIR_RNDS(_P1,2,3,0,1,40) PAIR_RNDS(_P2,2,3,0,1,40) PAIR_RNDS(_P1,3,0,1,2,44) PAIR_RNDS(_P2,3,0,1,2,44) \
+  PAIR_RNDS(_P1,0,1,2,3,48) PAIR_RNDS(_P2,0,1,2,3,48) PAIR_RNDSL(_P1,1,2,0,52) PAIR_RNDSL(_P2,1,2,0,52) \
+  PAIR_RNDSL(_P1,2,3,1,56) PAIR_RNDSL(_P2,2,3,1,56) PAIR_RNDS60(_P1) PAIR_RNDS60(_P2)
+
+#define PAIR_BLOCK_X3 \
+  PAIR_RNDS00(_P1) PAIR_RNDS00(_P2) PAIR_RNDS00(_P3) \
+  PAIR_RNDS04(_P1) PAIR_RNDS04(_P2) PAIR_RNDS04(_P3) \
+  PAIR_RNDS08(_P1) PAIR_RNDS08(_P2) PAIR_RNDS08(_P3) \
+  PAIR_RNDS12(_P1) PAIR_RNDS12(_P2) PAIR_RNDS12(_P3) \
+  PAIR_RNDS(_P1,0,1,2,3,16) PAIR_RNDS(_P2,0,1,2,3,16) PAIR_RNDS(_P3,0,1,2,3,16) \
+  PAIR_RNDS(_P1,1,2,3,0,20) PAIR_RNDS(_P2,1,2,3,0,20) PAIR_RNDS(_P3,1,2,3,0,20) \
+  PAIR_RNDS(_P1,2,3,0,1,24) PAIR_RNDS(_P2,2,3,0,1,24) PAIR_RNDS(_P3,2,3,0,1,24) \
+  PAIR_RNDS(_P1,3,0,1,2,28) PAIR_RNDS(_P2,3,0,1,2,28) PAIR_RNDS(_P3,3,0,1,2,28) \
+  PAIR_RNDS(_P1,0,1,2,3,32) PAIR_RNDS(_P2,0,1,2,3,32) PAIR_RNDS(_P3,0,1,2,3,32) \
+  PAIR_RNDS(_P1,1,2,3,0,36) PAIR_RNDS(_P2,1,2,3,0,36) PAIR_RNDS(_P3,1,2,3,0,36) \
+  PAIR_RNDS(_P1,2,3,0,1,40) PAIR_RNDS(_P2,2,3,0,1,40) PAIR_RNDS(_P3,2,3,0,1,40) \
+  PAIR_RNDS(_P1,3,0,1,2,44) PAIR_RNDS(_P2,3,0,1,2,44) PAIR_RNDS(_P3,3,0,1,2,44) \
+  PAIR_RNDS(_P1,0,1,2,3,48) PAIR_RNDS(_P2,0,1,2,3,48) PAIR_RNDS(_P3,0,1,2,3,48) \
+  PAIR_RNDSL(_P1,1,2,0,52) PAIR_RNDSL(_P2,1,2,0,52) PAIR_RNDSL(_P3,1,2,0,52) \
+  PAIR_RNDSL(_P1,2,3,1,56) PAIR_RNDSL(_P2,2,3,1,56) PAIR_RNDSL(_P3,2,3,1,56) \
+  PAIR_RNDS60(_P1) PAIR_RNDS60(_P2) PAIR_RNDS60(_P3)
+
+#define PAIR_BLOCK_X4 \
+  PAIR_RNDS00(_P1) PAIR_RNDS00(_P2) PAIR_RNDS00(_P3) PAIR_RNDS00(_P4) \
+  PAIR_RNDS04(_P1) PAIR_RNDS04(_P2) PAIR_RNDS04(_P3) PAIR_RNDS04(_P4) \
+  PAIR_RNDS08(_P1) PAIR_RNDS08(_P2) PAIR_RNDS08(_P3) PAIR_RNDS08(_P4) \
+  PAIR_RNDS12(_P1) PAIR_RNDS12(_P2) PAIR_RNDS12(_P3) PAIR_RNDS12(_P4) \
+  PAIR_RNDS(_P1,0,1,2,3,16) PAIR_RNDS(_P2,0,1,2,3,16) PAIR_RNDS(_P3,0,1,2,3,16) PAIR_RNDS(_P4,0,1,2,3,16) \
+  PAIR_RNDS(_P1,1,2,3,0,20) PAIR_RNDS(_P2,1,2,3,0,20) PAIR_RNDS(_P3,1,2,3,0,20) PAIR_RNDS(_P4,1,2,3,0,20) \
+  PAIR_RNDS(_P1,2,3,0,1,24) PAIR_RNDS(_P2,2,3,0,1,24) PAIR_RNDS(_P3,2,3,0,1,24) PAIR_RNDS(_P4,2,3,0,1,24) \
+  PAIR_RNDS(_P1,3,0,1,2,28) PAIR_RNDS(_P2,3,0,1,2,28) PAIR_RNDS(_P3,3,0,1,2,28) PAIR_RNDS(_P4,3,0,1,2,28) \
+  PAIR_RNDS(_P1,0,1,2,3,32) PAIR_RNDS(_P2,0,1,2,3,32) PAIR_RNDS(_P3,0,1,2,3,32) PAIR_RNDS(_P4,0,1,2,3,32) \
+  PAIR_RNDS(_P1,1,2,3,0,36) PAIR_RNDS(_P2,1,2,3,0,36) PAIR_RNDS(_P3,1,2,3,0,36) PAIR_RNDS(_P4,1,2,3,0,36) \
+  PAIR_RNDS(_P1,2,3,0,1,40) PAIR_RNDS(_P2,2,3,0,1,40) PAIR_RNDS(_P3,2,3,0,1,40) PAIR_RNDS(_P4,2,3,0,1,40) \
+  PAIR_RNDS(_P1,3,0,1,2,44) PAIR_RNDS(_P2,3,0,1,2,44) PAIR_RNDS(_P3,3,0,1,2,44) PAIR_RNDS(_P4,3,0,1,2,44) \
+  PAIR_RNDS(_P1,0,1,2,3,48) PAIR_RNDS(_P2,0,1,2,3,48) PAIR_RNDS(_P3,0,1,2,3,48) PAIR_RNDS(_P4,0,1,2,3,48) \
+  PAIR_RNDSL(_P1,1,2,0,52) PAIR_RNDSL(_P2,1,2,0,52) PAIR_RNDSL(_P3,1,2,0,52) PAIR_RNDSL(_P4,1,2,0,52) \
+  PAIR_RNDSL(_P1,2,3,1,56) PAIR_RNDSL(_P2,2,3,1,56) PAIR_RNDSL(_P3,2,3,1,56) PAIR_RNDSL(_P4,2,3,1,56) \
+  PAIR_RNDS60(_P1) PAIR_RNDS60(_P2) PAIR_RNDS60(_P3) PAIR_RNDS60(_P4)
+
+//-- 64 rounds of padding block (2nd block), precomputed W+K, x1 to x4 (interleaved per 4 rounds)
+#define PAIR_PADDED_X1 \
+  PAIR_RNDSW(_P1,0) PAIR_RNDSW(_P1,4) PAIR_RNDSW(_P1,8) PAIR_RNDSW(_P1,12) \
+  PAIR_RNDSW(_P1,16) PAIR_RNDSW(_P1,20) PAIR_RNDSW(_P1,24) PAIR_RNDSW(_P1,28) \
+  PAIR_RNDSW(_P1,32) PAIR_RNDSW(_P1,36) PAIR_RNDSW(_P1,40) PAIR_RNDSW(_P1,44) \
+  PAIR_RNDSW(_P1,48) PAIR_RNDSW(_P1,52) PAIR_RNDSW(_P1,56) PAIR_RNDSW(_P1,60)
+
+#define PAIR_PADDED_X2 \
+  PAIR_RNDSW(_P1,0) PAIR_RNDSW(_P2,0) PAIR_RNDSW(_P1,4) PAIR_RNDSW(_P2,4) \
+  PAIR_RNDSW(_P1,8) PAIR_RNDSW(_P2,8) PAIR_RNDSW(_P1,12) PAIR_RNDSW(_P2,12) \
+  PAIR_RNDSW(_P1,16) PAIR_RNDSW(_P2,16) PAIR_RNDSW(_P1,20) PAIR_RNDSW(_P2,20) \
+  PAIR_RNDSW(_P1,24) PAIR_RNDSW(_P2,24) PAIR_RNDSW(_P1,28) PAIR_RNDSW(_P2,28) \
+  PAIR_RNDSW(_P1,32) PAIR_RNDSW(_P2,32) PAIR_RNDSW(_P1,36) PAIR_RNDSW(_P2,36) \
+  PAIR_RNDSW(_P1,40) PAIR_RNDSW(_P2,40) PAIR_RNDSW(_P1,44) PAIR_RNDSW(_P2,44) \
+  PAIR_RNDSW(_P1,48) PAIR_RNDSW(_P2,48) PAIR_RNDSW(_P1,52) PAIR_RNDSW(_P2,52) \
+  PAIR_RNDSW(_P1,56) PAIR_RNDSW(_P2,56) PAIR_RNDSW(_P1,60) PAIR_RNDSW(_P2,60)
+
+#define PAIR_PADDED_X3 \
+  PAIR_RNDSW(_P1,0) PAIR_RNDSW(_P2,0) PAIR_RNDSW(_P3,0) \
+  PAIR_RNDSW(_P1,4) PAIR_RNDSW(_P2,4) PAIR_RNDSW(_P3,4) \
+  PAIR_RNDSW(_P1,8) PAIR_RNDSW(_P2,8) PAIR_RNDSW(_P3,8) \
+  PAIR_RNDSW(_P1,12) PAIR_RNDSW(_P2,12) PAIR_RNDSW(_P3,12) \
+  PAIR_RNDSW(_P1,16) PAIR_RNDSW(_P2,16) PAIR_RNDSW(_P3,16) \
+  PAIR_RNDSW(_P1,20) PAIR_RNDSW(_P2,20) PAIR_RNDSW(_P3,20) \
+  PAIR_RNDSW(_P1,24) PAIR_RNDSW(_P2,24) PAIR_RNDSW(_P3,24) \
+  PAIR_RNDSW(_P1,28) PAIR_RNDSW(_P2,28) PAIR_RNDSW(_P3,28) \
+  PAIR_RNDSW(_P1,32) PAIR_RNDSW(_P2,32) PAIR_RNDSW(_P3,32) \
+  PAIR_RNDSW(_P1,36) PAIR_RNDSW(_P2,36) PAIR_RNDSW(_P3,36) \
+  PAIR_RNDSW(_P1,40) PAIR_RNDSW(_P2,40) PAIR_RNDSW(_P3,40) \
+  PAIR_RNDSW(_P1,44) PAIR_RNDSW(_P2,44) PAIR_RNDSW(_P3,44) \
+  PAIR_RNDSW(_P1,48) PAIR_RNDSW(_P2,48) PAIR_RNDSW(_P3,48) \
+  PAIR_RNDSW(_P1,52) PAIR_RNDSW(_P2,52) PAIR_RNDSW(_P3,52) \
+  PAIR_RNDSW(_P1,56) PAIR_RNDSW(_P2,56) PAIR_RNDSW(_P3,56) \
+  PAIR_RNDSW(_P1,60) PAIR_RNDSW(_P2,60) PAIR_RNDSW(_P3,60)
+
+#define PAIR_PADDED_X4 \
+  PAIR_RNDSW(_P1,0) PAIR_RNDSW(_P2,0) PAIR_RNDSW(_P3,0) PAIR_RNDSW(_P4,0) \
+  PAIR_RNDSW(_P1,4) PAIR_RNDSW(_P2,4) PAIR_RNDSW(_P3,4) PAIR_RNDSW(_P4,4) \
+  PAIR_RNDSW(_P1,8) PAIR_RNDSW(_P2,8) PAIR_RNDSW(_P3,8) PAIR_RNDSW(_P4,8) \
+  PAIR_RNDSW(_P1,12) PAIR_RNDSW(_P2,12) PAIR_RNDSW(_P3,12) PAIR_RNDSW(_P4,12) \
+  PAIR_RNDSW(_P1,16) PAIR_RNDSW(_P2,16) PAIR_RNDSW(_P3,16) PAIR_RNDSW(_P4,16) \
+  PAIR_RNDSW(_P1,20) PAIR_RNDSW(_P2,20) PAIR_RNDSW(_P3,20) PAIR_RNDSW(_P4,20) \
+  PAIR_RNDSW(_P1,24) PAIR_RNDSW(_P2,24) PAIR_RNDSW(_P3,24) PAIR_RNDSW(_P4,24) \
+  PAIR_RNDSW(_P1,28) PAIR_RNDSW(_P2,28) PAIR_RNDSW(_P3,28) PAIR_RNDSW(_P4,28) \
+  PAIR_RNDSW(_P1,32) PAIR_RNDSW(_P2,32) PAIR_RNDSW(_P3,32) PAIR_RNDSW(_P4,32) \
+  PAIR_RNDSW(_P1,36) PAIR_RNDSW(_P2,36) PAIR_RNDSW(_P3,36) PAIR_RNDSW(_P4,36) \
+  PAIR_RNDSW(_P1,40) PAIR_RNDSW(_P2,40) PAIR_RNDSW(_P3,40) PAIR_RNDSW(_P4,40) \
+  PAIR_RNDSW(_P1,44) PAIR_RNDSW(_P2,44) PAIR_RNDSW(_P3,44) PAIR_RNDSW(_P4,44) \
+  PAIR_RNDSW(_P1,48) PAIR_RNDSW(_P2,48) PAIR_RNDSW(_P3,48) PAIR_RNDSW(_P4,48) \
+  PAIR_RNDSW(_P1,52) PAIR_RNDSW(_P2,52) PAIR_RNDSW(_P3,52) PAIR_RNDSW(_P4,52) \
+  PAIR_RNDSW(_P1,56) PAIR_RNDSW(_P2,56) PAIR_RNDSW(_P3,56) PAIR_RNDSW(_P4,56) \
+  PAIR_RNDSW(_P1,60) PAIR_RNDSW(_P2,60) PAIR_RNDSW(_P3,60) PAIR_RNDSW(_P4,60)
+
+//-- array of 64x constants for SHA256 rounds
+alignas(64) static const uint32_t K64[64] = {
+  0x428A2F98,0x71374491,0xB5C0FBCF,0xE9B5DBA5,0x3956C25B,0x59F111F1,0x923F82A4,0xAB1C5ED5,
+  0xD807AA98,0x12835B01,0x243185BE,0x550C7DC3,0x72BE5D74,0x80DEB1FE,0x9BDC06A7,0xC19BF174,
+  0xE49B69C1,0xEFBE4786,0x0FC19DC6,0x240CA1CC,0x2DE92C6F,0x4A7484AA,0x5CB0A9DC,0x76F988DA,
+  0x983E5152,0xA831C66D,0xB00327C8,0xBF597FC7,0xC6E00BF3,0xD5A79147,0x06CA6351,0x14292967,
+  0x27B70A85,0x2E1B2138,0x4D2C6DFC,0x53380D13,0x650A7354,0x766A0ABB,0x81C2C92E,0x92722C85,
+  0xA2BFE8A1,0xA81A664B,0xC24B8B70,0xC76C51A3,0xD192E819,0xD6990624,0xF40E3585,0x106AA070,
+  0x19A4C116,0x1E376C08,0x2748774C,0x34B0BCB5,0x391C0CB3,0x4ED8AA4A,0x5B9CCA4F,0x682E6FF3,
+  0x748F82EE,0x78A5636F,0x84C87814,0x8CC70208,0x90BEFFFA,0xA4506CEB,0xBEF9A3F7,0xC67178F2
+ };
+
+//-- array of 64x W+K of padding block (2nd block), SHA256 padding logic (64bytes), precomputed
+alignas(64) static const uint32_t WK2[64] = {
+  0xC28A2F98,0x71374491,0xB5C0FBCF,0xE9B5DBA5,0x3956C25B,0x59F111F1,0x923F82A4,0xAB1C5ED5,
+  0xD807AA98,0x12835B01,0x243185BE,0x550C7DC3,0x72BE5D74,0x80DEB1FE,0x9BDC06A7,0xC19BF374,
+  0x649B69C1,0xF0FE4786,0x0FE1EDC6,0x240CF254,0x4FE9346F,0x6CC984BE,0x61B9411E,0x16F988FA,
+  0xF2C65152,0xA88E5A6D,0xB019FC65,0xB9D99EC7,0x9A1231C3,0xE70EEAA0,0xFDB1232B,0xC7353EB0,
+  0x3069BAD5,0xCB976D5F,0x5A0F118F,0xDC1EEEFD,0x0A35B689,0xDE0B7A04,0x58F4CA9D,0xE15D5B16,
+  0x007F3E86,0x37088980,0xA507EA32,0x6FAB9537,0x17406110,0x0D8CD6F1,0xCDAA3B6D,0xC0BBBE37,
+  0x83613BDA,0xDB48A363,0x0B02E931,0x6FD15CA7,0x521AFACA,0x31338431,0x6ED41A95,0x6D437890,
+  0xC39C91F2,0x9ECCABBD,0xB5C9A0E6,0x532FB63C,0xD2C741C6,0x07237EA3,0xA4954B68,0x4C191D76
+ };
+
+void rsha256_pair_x1(        //-- no return value, result to *out
+uint8_t*       out,          //-- output num_pairs x 32bytes SHA256 values (may be same as *in)
+const uint8_t* in,           //-- input num_pairs x 64bytes data (left||right 32bytes hashes)
+const uint64_t num_pairs)    //-- number of 64bytes to SHA256
+{
+
+ //-- shuffle mask for byte order required by SHA Extensions
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+
+ //-- pre-arranged/shuffled state values for SHA256 rounds, A-H logic
+ const __m128i ABEF_INIT = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ const __m128i CDGH_INIT = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+
+ //-- variables to calculate SHA256 rounds
+ __m128i STATE0_P1; __m128i STATE1_P1; __m128i SAVE0_P1; __m128i SAVE1_P1; __m128i MSGV_P1; __m128i MSGTMP0_P1; __m128i MSGTMP1_P1; __m128i MSGTMP2_P1; __m128i MSGTMP3_P1;
+
+ //-- 1x pair at a time
+ for(uint64_t i = 0; i < num_pairs; ++i){
+   PAIR_LOAD(_P1,&in[64 * i]);
+   PAIR_BLOCK_X1
+   PAIR_NEXT(_P1);
+   PAIR_PADDED_X1
+   PAIR_STORE(_P1,&out[32 * i]);
+   }
+}
+
+void rsha256_pair_x2(        //-- no return value, result to *out
+uint8_t*       out,          //-- output num_pairs x 32bytes SHA256 values (may be same as *in)
+const uint8_t* in,           //-- input num_pairs x 64bytes data (left||right 32bytes hashes)
+const uint64_t num_pairs)    //-- number of 64bytes to SHA256
+{
+
+ //-- shuffle mask for byte order required by SHA Extensions
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+
+ //-- pre-arranged/shuffled state values for SHA256 rounds, A-H logic
+ const __m128i ABEF_INIT = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ const __m128i CDGH_INIT = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+
+ //-- variables to calculate SHA256 rounds
+ __m128i STATE0_P1; __m128i STATE1_P1; __m128i SAVE0_P1; __m128i SAVE1_P1; __m128i MSGV_P1; __m128i MSGTMP0_P1; __m128i MSGTMP1_P1; __m128i MSGTMP2_P1; __m128i MSGTMP3_P1;
+ __m128i STATE0_P2; __m128i STATE1_P2; __m128i SAVE0_P2; __m128i SAVE1_P2; __m128i MSGV_P2; __m128i MSGTMP0_P2; __m128i MSGTMP1_P2; __m128i MSGTMP2_P2; __m128i MSGTMP3_P2;
+
+ //-- 2x pairs at a time, pipelined
+ uint64_t i = 0;
+ for(; i + 2 <= num_pairs; i += 2){
+   PAIR_LOAD(_P1,&in[64 * i]);
+   PAIR_LOAD(_P2,&in[64 * (i + 1)]);
+   PAIR_BLOCK_X2
+   PAIR_NEXT(_P1);
+   PAIR_NEXT(_P2);
+   PAIR_PADDED_X2
+   PAIR_STORE(_P1,&out[32 * i]);
+   PAIR_STORE(_P2,&out[32 * (i + 1)]);
+   }
+
+ //-- rest of pairs, if any
+ if(i < num_pairs){ rsha256_pair_x1(&out[32 * i],&in[64 * i],num_pairs - i); }
+}
+
+void rsha256_pair_x3(        //-- no return value, result to *out
+uint8_t*       out,          //-- output num_pairs x 32bytes SHA256 values (may be same as *in)
+const uint8_t* in,           //-- input num_pairs x 64bytes data (left||right 32bytes hashes)
+const uint64_t num_pairs)    //-- number of 64bytes to SHA256
+{
+
+ //-- shuffle mask for byte order required by SHA Extensions
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+
+ //-- pre-arranged/shuffled state values for SHA256 rounds, A-H logic
+ const __m128i ABEF_INIT = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ const __m128i CDGH_INIT = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+
+ //-- variables to calculate SHA256 rounds
+ __m128i STATE0_P1; __m128i STATE1_P1; __m128i SAVE0_P1; __m128i SAVE1_P1; __m128i MSGV_P1; __m128i MSGTMP0_P1; __m128i MSGTMP1_P1; __m128i MSGTMP2_P1; __m128i MSGTMP3_P1;
+ __m128i STATE0_P2; __m128i STATE1_P2; __m128i SAVE0_P2; __m128i SAVE1_P2; __m128i MSGV_P2; __m128i MSGTMP0_P2; __m128i MSGTMP1_P2; __m128i MSGTMP2_P2; __m128i MSGTMP3_P2;
+ __m128i STATE0_P3; __m128i STATE1_P3; __m128i SAVE0_P3; __m128i SAVE1_P3; __m128i MSGV_P3; __m128i MSGTMP0_P3; __m128i MSGTMP1_P3; __m128i MSGTMP2_P3; __m128i MSGTMP3_P3;
+
+ //-- 3x pairs at a time, pipelined
+ uint64_t i = 0;
+ for(; i + 3 <= num_pairs; i += 3){
+   PAIR_LOAD(_P1,&in[64 * i]);
+   PAIR_LOAD(_P2,&in[64 * (i + 1)]);
+   PAIR_LOAD(_P3,&in[64 * (i + 2)]);
+   PAIR_BLOCK_X3
+   PAIR_NEXT(_P1);
+   PAIR_NEXT(_P2);
+   PAIR_NEXT(_P3);
+   PAIR_PADDED_X3
+   PAIR_STORE(_P1,&out[32 * i]);
+   PAIR_STORE(_P2,&out[32 * (i + 1)]);
+   PAIR_STORE(_P3,&out[32 * (i + 2)]);
+   }
+
+ //-- rest of pairs, if any
+ if(i < num_pairs){ rsha256_pair_x2(&out[32 * i],&in[64 * i],num_pairs - i); }
+}
+
+void rsha256_pair_x4(        //-- no return value, result to *out
+uint8_t*       out,          //-- output num_pairs x 32bytes SHA256 values (may be same as *in)
+const uint8_t* in,           //-- input num_pairs x 64bytes data (left||right 32bytes hashes)
+const uint64_t num_pairs)    //-- number of 64bytes to SHA256
+{
+
+ //-- shuffle mask for byte order required by SHA Extensions
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+
+ //-- pre-arranged/shuffled state values for SHA256 rounds, A-H logic
+ const __m128i ABEF_INIT = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ const __m128i CDGH_INIT = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+
+ //-- variables to calculate SHA256 rounds
+ __m128i STATE0_P1; __m128i STATE1_P1; __m128i SAVE0_P1; __m128i SAVE1_P1; __m128i MSGV_P1; __m128i MSGTMP0_P1; __m128i MSGTMP1_P1; __m128i MSGTMP2_P1; __m128i MSGTMP3_P1;
+ __m128i STATE0_P2; __m128i STATE1_P2; __m128i SAVE0_P2; __m128i SAVE1_P2; __m128i MSGV_P2; __m128i MSGTMP0_P2; __m128i MSGTMP1_P2; __m128i MSGTMP2_P2; __m128i MSGTMP3_P2;
+ __m128i STATE0_P3; __m128i STATE1_P3; __m128i SAVE0_P3; __m128i SAVE1_P3; __m128i MSGV_P3; __m128i MSGTMP0_P3; __m128i MSGTMP1_P3; __m128i MSGTMP2_P3; __m128i MSGTMP3_P3;
+ __m128i STATE0_P4; __m128i STATE1_P4; __m128i SAVE0_P4; __m128i SAVE1_P4; __m128i MSGV_P4; __m128i MSGTMP0_P4; __m128i MSGTMP1_P4; __m128i MSGTMP2_P4; __m128i MSGTMP3_P4;
+
+ //-- 4x pairs at a time, pipelined
+ uint64_t i = 0;
+ for(; i + 4 <= num_pairs; i += 4){
+   PAIR_LOAD(_P1,&in[64 * i]);
+   PAIR_LOAD(_P2,&in[64 * (i + 1)]);
+   PAIR_LOAD(_P3,&in[64 * (i + 2)]);
+   PAIR_LOAD(_P4,&in[64 * (i + 3)]);
+   PAIR_BLOCK_X4
+   PAIR_NEXT(_P1);
+   PAIR_NEXT(_P2);
+   PAIR_NEXT(_P3);
+   PAIR_NEXT(_P4);
+   PAIR_PADDED_X4
+   PAIR_STORE(_P1,&out[32 * i]);
+   PAIR_STORE(_P2,&out[32 * (i + 1)]);
+   PAIR_STORE(_P3,&out[32 * (i + 2)]);
+   PAIR_STORE(_P4,&out[32 * (i + 3)]);
+   }
+
+ //-- rest of pairs, if any
+ if(i < num_pairs){ rsha256_pair_x2(&out[32 * i],&in[64 * i],num_pairs - i); }
+}
+
+void rsha256_pair(           //-- no return value, result to *out
+uint8_t*       out,          //-- output num_pairs x 32bytes SHA256 values (may be same as *in)
+const uint8_t* in,           //-- input num_pairs x 64bytes data (left||right 32bytes hashes)
+const uint64_t num_pairs)    //-- number of 64bytes to SHA256
+{
+ rsha256_pair_x2(out,in,num_pairs);
+}
+
+#endif
+
+// <eof>
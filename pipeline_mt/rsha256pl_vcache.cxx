@@ -0,0 +1,189 @@
+/*
+ * File: rsha256pl_vcache.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Cache of already verified VDF segments
+ * Bounded, lock-striped hash table, (start hash, iterations) -> end hash
+ *
+ * Same segments are often verified several times (same proof from
+ * several peers, re-org). A lookup is nanoseconds, a segment is millions
+ * of SHA256 iterations.
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <mutex>
+#include <new>
+
+#include "rsha256pl_verify.h"
+
+//-- number of stripes (locks), and entries (ways) per set
+#define RSHA256PL_VCACHE_STRIPES 64
+#define RSHA256PL_VCACHE_WAYS    4
+
+//-- 1x cached segment, stamp 0 = empty
+struct local_vcentry {
+ uint8_t  start[32];
+ uint8_t  end[32];
+ uint64_t iters;
+ uint64_t stamp;
+ };
+
+//-- 1x stripe, own lock and sets, on separate cache lines
+struct alignas(64) local_vcstripe {
+ std::mutex     lock;
+ uint64_t       stamp;
+ uint32_t       entries;
+ uint32_t       cap;      //-- max entries in stripe, less than sets x ways only if max_entries below 1x set per stripe
+ local_vcentry* sets;
+ };
+
+struct rsha256_vcache {
+ local_vcstripe        stripes[RSHA256PL_VCACHE_STRIPES];
+ uint32_t              setmask;
+ std::atomic<uint64_t> hits;
+ std::atomic<uint64_t> misses;
+ };
+
+//-- local_VCacheKey() - key of segment, start hash is already SHA256 output (uniform)
+static inline uint64_t local_VCacheKey(const uint8_t* start,const uint64_t iters)
+{
+ uint64_t key;
+ memcpy(&key,start,8);
+ return key ^ (iters * 0x9E3779B97F4A7C15ULL);
+}
+
+//-- rsha256_vcache_create() - new cache, max_entries rounded down to power of 2 sets, min 1x set per stripe
+rsha256_vcache* rsha256_vcache_create(
+const uint32_t max_entries)
+{
+ uint32_t sets = 1;
+ uint64_t want = (uint64_t)max_entries / (RSHA256PL_VCACHE_STRIPES * RSHA256PL_VCACHE_WAYS);
+ while((uint64_t)sets * 2 <= want && sets < 0x10000000) sets <<= 1;
+
+ rsha256_vcache* cache = new(std::nothrow) rsha256_vcache;
+ if(cache == NULL) return NULL;
+ cache->setmask = sets - 1;
+ cache->hits = 0;
+ cache->misses = 0;
+ for(uint32_t s = 0; s < RSHA256PL_VCACHE_STRIPES; ++s){ cache->stripes[s].sets = NULL; }
+
+ for(uint32_t s = 0; s < RSHA256PL_VCACHE_STRIPES; ++s){
+   local_vcstripe* stripe = &cache->stripes[s];
+   stripe->stamp = 0;
+   stripe->entries = 0;
+   stripe->cap = max_entries / RSHA256PL_VCACHE_STRIPES + ((s < max_entries % RSHA256PL_VCACHE_STRIPES) ? 1 : 0);
+   if(stripe->cap > sets * RSHA256PL_VCACHE_WAYS) stripe->cap = sets * RSHA256PL_VCACHE_WAYS;
+   stripe->sets = new(std::nothrow) local_vcentry[(size_t)sets * RSHA256PL_VCACHE_WAYS];
+   if(stripe->sets == NULL){ rsha256_vcache_destroy(cache); return NULL; }
+   memset(stripe->sets,0,sizeof(local_vcentry) * sets * RSHA256PL_VCACHE_WAYS);
+   }
+
+ return cache;
+}
+
+//-- rsha256_vcache_destroy() - free cache
+void rsha256_vcache_destroy(
+rsha256_vcache* cache)
+{
+ if(cache == NULL) return;
+ for(uint32_t s = 0; s < RSHA256PL_VCACHE_STRIPES; ++s){ delete[] cache->stripes[s].sets; }
+ delete cache;
+}
+
+//-- rsha256_vcache_lookup() - find segment, refresh stamp if found
+bool rsha256_vcache_lookup(
+rsha256_vcache* cache,
+const uint8_t*  start,
+const uint64_t  iters,
+uint8_t*        end)
+{
+ if(cache == NULL) return false;
+
+ uint64_t key = local_VCacheKey(start,iters);
+ local_vcstripe* stripe = &cache->stripes[key % RSHA256PL_VCACHE_STRIPES];
+ bool found = false;
+
+ {
+ std::lock_guard<std::mutex> guard(stripe->lock);
+ local_vcentry* set = &stripe->sets[((key >> 16) & cache->setmask) * RSHA256PL_VCACHE_WAYS];
+ for(uint32_t w = 0; w < RSHA256PL_VCACHE_WAYS; ++w){
+   if(set[w].stamp != 0 && set[w].iters == iters && !memcmp(set[w].start,start,32)){
+     set[w].stamp = ++stripe->stamp;
+     memcpy(end,set[w].end,32);
+     found = true;
+     break;
+     }
+   }
+ }
+
+ if(found) cache->hits.fetch_add(1,std::memory_order_relaxed);
+ else      cache->misses.fetch_add(1,std::memory_order_relaxed);
+ return found;
+}
+
+//-- rsha256_vcache_insert() - add/update segment, replace least recently used in set
+void rsha256_vcache_insert(
+rsha256_vcache* cache,
+const uint8_t*  start,
+const uint64_t  iters,
+const uint8_t*  end)
+{
+ if(cache == NULL) return;
+
+ uint64_t key = local_VCacheKey(start,iters);
+ local_vcstripe* stripe = &cache->stripes[key % RSHA256PL_VCACHE_STRIPES];
+
+ std::lock_guard<std::mutex> guard(stripe->lock);
+ local_vcentry* set = &stripe->sets[((key >> 16) & cache->setmask) * RSHA256PL_VCACHE_WAYS];
+ local_vcentry* slot = &set[0];
+ for(uint32_t w = 0; w < RSHA256PL_VCACHE_WAYS; ++w){
+   if(set[w].stamp != 0 && set[w].iters == iters && !memcmp(set[w].start,start,32)){ slot = &set[w]; break; }
+   if(set[w].stamp < slot->stamp) slot = &set[w];
+   }
+
+ //-- stripe full (small cache), replace least recently used entry of set instead of empty way
+ if(slot->stamp == 0 && stripe->entries >= stripe->cap){
+   slot = NULL;
+   for(uint32_t w = 0; w < RSHA256PL_VCACHE_WAYS; ++w){
+     if(set[w].stamp != 0 && (slot == NULL || set[w].stamp < slot->stamp)) slot = &set[w];
+     }
+   if(slot == NULL) return;
+   }
+
+ if(slot->stamp == 0) ++stripe->entries;
+ memcpy(slot->start,start,32);
+ memcpy(slot->end,end,32);
+ slot->iters = iters;
+ slot->stamp = ++stripe->stamp;
+}
+
+//-- rsha256_vcache_stats() - hits/misses since create, number of segments in cache
+void rsha256_vcache_stats(
+rsha256_vcache* cache,
+uint64_t*       hits,
+uint64_t*       misses,
+uint32_t*       entries)
+{
+ if(cache == NULL) return;
+ if(hits != NULL) *hits = cache->hits.load(std::memory_order_relaxed);
+ if(misses != NULL) *misses = cache->misses.load(std::memory_order_relaxed);
+ if(entries != NULL){
+   *entries = 0;
+   for(uint32_t s = 0; s < RSHA256PL_VCACHE_STRIPES; ++s){
+     std::lock_guard<std::mutex> guard(cache->stripes[s].lock);
+     *entries += cache->stripes[s].entries;
+     }
+   }
+}
+
+// <eof>
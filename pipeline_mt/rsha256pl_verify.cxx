@@ -0,0 +1,540 @@
+/*
+ * File: rsha256pl_verify.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Verify VDF segments/checkpoints with pipelined fast recursive SHA256
+ * Multithreaded, each thread runs segments in lanes of _x2 (default)
+ *
+ * rsha256_vengine_*()   - Engine, worker threads and queue of jobs
+ * rsha256_verify_segs() - Verify array of segments (start, end, iterations)
+ * rsha256_verify()      - Verify chain of checkpoints from start hash
+ * rsha256_verify_infused() - Verify chain of checkpoints, with infusions
+ *
+ * Jobs have priority and deadline. Workers always take segments of most
+ * urgent job, and at chunk boundaries park running segments of a less
+ * urgent job if a more urgent one is waiting (preempt).
+ *
+ * Segments found in cache (rsha256pl_vcache.cxx) are not recomputed
+ *
+ * Segments with infusions stop lanes at each infusion point, that iteration
+ * is SHA256(hash||data) by rsha256pl_pair_*.cxx, plain lanes in between
+ *
+ * Threads sized by CPU budget (rsha256pl_budget.cxx) if 0 given. Budget
+ * below threads running is met by duty cycle, sleep at chunk boundaries,
+ * instead of CFS throttling all threads at once by cgroup quota.
+ *
+ * Requirement: rsha256pl_fast_x64.cxx or rsha256pl_fast_arm.cxx, rsha256pl_budget.cxx,
+ *              rsha256pl_pair_x64.cxx or rsha256pl_pair_arm.cxx
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rsha256pl_verify.h"
+
+//-- number of lanes (pipelined edition) per thread, _x2 best in most cases (RESULTS.md)
+#ifndef RSHA256PL_VERIFY_LANES
+#define RSHA256PL_VERIFY_LANES 2
+#endif
+
+//-- max iterations run by lanes before next schedule decision (preempt, drop)
+#ifndef RSHA256PL_VERIFY_CHUNK
+#define RSHA256PL_VERIFY_CHUNK 1000000
+#endif
+
+//-- pipelined editions, index by number of lanes - 1
+static void (* const local_fastxn[4])(uint8_t*,const uint64_t) = {
+ &rsha256_fast_x1, &rsha256_fast_x2, &rsha256_fast_x3, &rsha256_fast_x4 };
+
+//-- 1x segment parked by preempt, resumes from hash after iterations done
+struct local_vpark {
+ uint32_t seg;
+ uint64_t left;
+ uint8_t  hash[32];
+ };
+
+//-- 1x job, segments of 1x submit
+struct rsha256_vjob {
+ const rsha256_vseg*      segs;
+ uint32_t                 num_segs;
+ std::vector<uint32_t>    todo;
+ uint32_t                 next;
+ std::vector<local_vpark> parked;
+ uint32_t                 running;
+ uint32_t                 fail;
+ int32_t                  priority;
+ uint64_t                 deadline;
+ uint64_t                 order;
+ bool                     done;
+ };
+
+struct rsha256_vengine {
+ std::mutex                 lock;
+ std::condition_variable    wake;
+ std::condition_variable    finished;
+ std::vector<rsha256_vjob*> jobs;
+ std::vector<std::thread>   workers;
+ std::atomic<uint64_t>      submits;
+ std::atomic<uint32_t>      active;
+ std::atomic<uint32_t>      duty_ppm;
+ uint64_t                   order;
+ bool                       stop;
+ rsha256_vcache*            cache;
+ };
+
+//-- local_NowNs() - monotonic time in nanoseconds
+static inline uint64_t local_NowNs()
+{
+ return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//-- local_JobBefore() - true if job a more urgent than b, priority, then deadline, then order
+static inline bool local_JobBefore(const rsha256_vjob* a,const rsha256_vjob* b)
+{
+ if(a->priority != b->priority) return (a->priority > b->priority);
+ if(a->deadline != b->deadline) return (a->deadline < b->deadline);
+ return (a->order < b->order);
+}
+
+//-- local_JobPending() - true if job has segments not running (new or parked)
+static inline bool local_JobPending(const rsha256_vjob* job)
+{
+ return (!job->parked.empty() || job->next < job->todo.size());
+}
+
+//-- local_JobBest() - most urgent job with pending segments, NULL if none (lock held)
+static rsha256_vjob* local_JobBest(rsha256_vengine* engine)
+{
+ rsha256_vjob* best = NULL;
+ for(rsha256_vjob* job : engine->jobs){
+   if(local_JobPending(job) && (best == NULL || local_JobBefore(job,best))) best = job;
+   }
+ return best;
+}
+
+//-- local_JobFail() - record failing segment, keep lowest index (lock held)
+static inline void local_JobFail(rsha256_vjob* job,uint32_t seg)
+{
+ if(seg < job->fail) job->fail = seg;
+}
+
+//-- local_JobCheckDone() - mark job done if nothing pending/running, drop from list (lock held)
+static void local_JobCheckDone(rsha256_vengine* engine,rsha256_vjob* job)
+{
+ if(job->done || job->running > 0) return;
+ while(!job->parked.empty() && job->parked.back().seg > job->fail) job->parked.pop_back();
+ while(job->next < job->todo.size() && job->todo[job->next] > job->fail) job->next = (uint32_t)job->todo.size();
+ if(local_JobPending(job)) return;
+ job->done = true;
+ for(size_t i = 0; i < engine->jobs.size(); ++i){
+   if(engine->jobs[i] == job){ engine->jobs[i] = engine->jobs.back(); engine->jobs.pop_back(); break; }
+   }
+ engine->finished.notify_all();
+}
+
+//-- local_InfusionNext() - index of first infusion after lane position, iters_left of segment to go
+static uint32_t local_InfusionNext(const rsha256_vseg* seg,const uint64_t iters_left)
+{
+ const uint64_t at = seg->start_iters + seg->iters - iters_left;
+ uint32_t lo = 0;
+ uint32_t hi = seg->num_infusions;
+ while(lo < hi){
+   uint32_t mid = lo + (hi - lo) / 2;
+   if(seg->infusions[mid].iter <= at) lo = mid + 1;
+   else hi = mid;
+   }
+ return lo;
+}
+
+//-- local_InfusionValid() - true if infusion schedule of segment strictly ascending, 1x per iteration
+static bool local_InfusionValid(const rsha256_vseg* seg)
+{
+ for(uint32_t i = 1; i < seg->num_infusions; ++i){
+   if(seg->infusions[i].iter <= seg->infusions[i - 1].iter) return false;
+   }
+ return true;
+}
+
+//-- local_InfusionRun() - plain iterations of lane before next infusion in segment, iters_left if none
+static inline uint64_t local_InfusionRun(const rsha256_vseg* seg,const uint32_t inf,const uint64_t iters_left)
+{
+ const uint64_t at = seg->start_iters + seg->iters - iters_left;
+ if(inf >= seg->num_infusions || seg->infusions[inf].iter > at + iters_left) return iters_left;
+ return seg->infusions[inf].iter - at - 1;
+}
+
+//-- local_InfusionApply() - due infusions of lane, SHA256(hash||data) as 1x iteration each
+static void local_InfusionApply(const rsha256_vseg* seg,uint8_t* hash,uint64_t& iters_left,uint32_t& inf)
+{
+ alignas(64) uint8_t msg[64];
+ while(iters_left > 0 && local_InfusionRun(seg,inf,iters_left) == 0){
+   memcpy(&msg[0],hash,32);
+   memcpy(&msg[32],seg->infusions[inf].data,32);
+   rsha256_pair(hash,msg,1);
+   --iters_left;
+   ++inf;
+   }
+}
+
+//-- local_VerifyWorker() - fill lanes from most urgent jobs, run chunk, repeat
+static void local_VerifyWorker(rsha256_vengine* engine,const uint32_t id)
+{
+ alignas(64) uint8_t lanehash[32 * 4];
+ rsha256_vjob* lanejob[4];
+ uint32_t laneseg[4];
+ uint64_t laneleft[4];
+ uint32_t laneinf[4];
+ bool     laneok[4];
+ uint32_t lanes = 0;
+ int64_t  debt = 0;
+
+ std::unique_lock<std::mutex> lk(engine->lock);
+
+ for(;;){
+
+   //-- fill empty lanes with segments of most urgent jobs, parked first
+   while(lanes < RSHA256PL_VERIFY_LANES && id < engine->active.load()){
+     rsha256_vjob* job = local_JobBest(engine);
+     if(job == NULL) break;
+     if(!job->parked.empty()){
+       local_vpark* park = &job->parked.back();
+       if(park->seg <= job->fail){
+         memcpy(&lanehash[32 * lanes],park->hash,32);
+         laneseg[lanes] = park->seg;
+         laneleft[lanes] = park->left;
+         laneinf[lanes] = (job->segs[park->seg].num_infusions > 0) ? local_InfusionNext(&job->segs[park->seg],park->left) : 0;
+         lanejob[lanes] = job;
+         ++job->running;
+         ++lanes;
+         }
+       job->parked.pop_back();
+       }
+     else{
+       uint32_t seg = job->todo[job->next++];
+       if(seg <= job->fail){
+         memcpy(&lanehash[32 * lanes],job->segs[seg].start,32);
+         laneseg[lanes] = seg;
+         laneleft[lanes] = job->segs[seg].iters;
+         laneinf[lanes] = (job->segs[seg].num_infusions > 0) ? local_InfusionNext(&job->segs[seg],job->segs[seg].iters) : 0;
+         lanejob[lanes] = job;
+         ++job->running;
+         ++lanes;
+         }
+       }
+     local_JobCheckDone(engine,job);
+     }
+
+   if(lanes == 0){
+     if(engine->stop) return;
+     engine->wake.wait(lk);
+     continue;
+     }
+
+   //-- run all lanes to first segment done, or max chunk, without lock
+   uint64_t submits = engine->submits.load();
+   lk.unlock();
+
+   //-- lanes with infusions stop at next infusion point, due infusions applied per lane
+   uint64_t run = RSHA256PL_VERIFY_CHUNK;
+   uint64_t busy = local_NowNs();
+   for(uint32_t i = 0; i < lanes; ++i){
+     const rsha256_vseg* seg = &lanejob[i]->segs[laneseg[i]];
+     if(seg->num_infusions > 0){
+       local_InfusionApply(seg,&lanehash[32 * i],laneleft[i],laneinf[i]);
+       uint64_t plain = local_InfusionRun(seg,laneinf[i],laneleft[i]);
+       if(plain < run) run = plain;
+       }
+     else if(laneleft[i] < run) run = laneleft[i];
+     }
+   if(run > 0) local_fastxn[lanes - 1](lanehash,run);
+
+   for(uint32_t i = 0; i < lanes; ++i){
+     laneleft[i] -= run;
+     const rsha256_vseg* seg = &lanejob[i]->segs[laneseg[i]];
+     if(seg->num_infusions > 0) local_InfusionApply(seg,&lanehash[32 * i],laneleft[i],laneinf[i]);
+     if(laneleft[i] > 0) continue;
+     laneok[i] = !memcmp(&lanehash[32 * i],seg->end,32);
+     if(laneok[i] && engine->cache != NULL && seg->num_infusions == 0){ rsha256_vcache_insert(engine->cache,seg->start,seg->iters,&lanehash[32 * i]); }
+     }
+   busy = local_NowNs() - busy;
+
+   lk.lock();
+
+   //-- most urgent pending job, only if new jobs submitted since lanes were filled
+   rsha256_vjob* best = (engine->submits.load() != submits) ? local_JobBest(engine) : NULL;
+   bool idle = (id >= engine->active.load());
+   bool parked = false;
+
+   //-- done segments, segments after a failing one, preempted by more urgent job, or idle by budget, keep lanes packed
+   for(uint32_t i = lanes; i-- > 0;){
+     rsha256_vjob* job = lanejob[i];
+     if(laneleft[i] == 0){
+       if(!laneok[i]) local_JobFail(job,laneseg[i]);
+       }
+     else if(laneseg[i] > job->fail){
+       }
+     else if(idle || (best != NULL && local_JobBefore(best,job))){
+       local_vpark park;
+       park.seg = laneseg[i];
+       park.left = laneleft[i];
+       memcpy(park.hash,&lanehash[32 * i],32);
+       job->parked.push_back(park);
+       parked = true;
+       }
+     else{
+       continue;
+       }
+     --job->running;
+     local_JobCheckDone(engine,job);
+     --lanes;
+     if(i != lanes){
+       memcpy(&lanehash[32 * i],&lanehash[32 * lanes],32);
+       lanejob[i] = lanejob[lanes];
+       laneseg[i] = laneseg[lanes];
+       laneleft[i] = laneleft[lanes];
+       laneinf[i] = laneinf[lanes];
+       }
+     }
+   if(parked) engine->wake.notify_all();
+
+   //-- duty cycle, sleep (busy x idle/duty) at chunk boundary, in steps of min 1ms
+   uint32_t duty = engine->duty_ppm.load();
+   if(duty < 1000000){
+     debt += (int64_t)(busy * (1000000 - duty) / duty);
+     if(debt >= 1000000){
+       lk.unlock();
+       uint64_t slept = local_NowNs();
+       std::this_thread::sleep_for(std::chrono::nanoseconds(debt));
+       slept = local_NowNs() - slept;
+       debt -= (int64_t)slept;
+       lk.lock();
+       }
+     }
+   else{
+     debt = 0;
+     }
+   }
+}
+
+//-- rsha256_vengine_create() - new engine, start worker threads
+rsha256_vengine* rsha256_vengine_create(
+const uint32_t  threads,
+rsha256_vcache* cache)
+{
+ rsha256_vengine* engine = new rsha256_vengine;
+ engine->submits = 0;
+ engine->order = 0;
+ engine->stop = false;
+ engine->cache = cache;
+
+ //-- threads given, or threads and duty cycle by CPU budget
+ uint32_t nthreads = threads;
+ uint32_t duty = 1000000;
+ if(nthreads == 0){
+   rsha256_cpubudget budget;
+   rsha256_cpu_budget(&budget,1.0);
+   nthreads = budget.threads;
+   duty = (uint32_t)(budget.duty * 1000000.0);
+   }
+ if(nthreads < 1) nthreads = 1;
+ engine->active = nthreads;
+ engine->duty_ppm = duty;
+
+ for(uint32_t t = 0; t < nthreads; ++t){ engine->workers.emplace_back(local_VerifyWorker,engine,t); }
+ return engine;
+}
+
+//-- rsha256_vengine_budget() - limit engine to fraction of CPU budget, threads above budget idle
+uint32_t rsha256_vengine_budget(
+rsha256_vengine* engine,
+const double     fraction)
+{
+ rsha256_cpubudget budget;
+ rsha256_cpu_budget(&budget,fraction);
+
+ uint32_t active = budget.threads;
+ if(active > engine->workers.size()) active = (uint32_t)engine->workers.size();
+ double duty = budget.cpus_budget / (double)active;
+ if(duty > 0.99) duty = 1.0;
+
+ {
+ std::lock_guard<std::mutex> guard(engine->lock);
+ engine->active = active;
+ engine->duty_ppm = (uint32_t)(duty * 1000000.0);
+ }
+ engine->wake.notify_all();
+ return active;
+}
+
+//-- rsha256_vengine_destroy() - finish running jobs, stop worker threads, free engine
+void rsha256_vengine_destroy(
+rsha256_vengine* engine)
+{
+ if(engine == NULL) return;
+ {
+ std::lock_guard<std::mutex> guard(engine->lock);
+ engine->stop = true;
+ }
+ engine->wake.notify_all();
+ for(std::thread& worker : engine->workers){ worker.join(); }
+ delete engine;
+}
+
+//-- rsha256_vengine_submit() - queue segments as 1x job, cache first
+rsha256_vjob* rsha256_vengine_submit(
+rsha256_vengine*    engine,
+const rsha256_vseg* segs,
+const uint32_t      num_segs,
+const int32_t       priority,
+const uint64_t      deadline_ms)
+{
+ rsha256_vjob* job = new rsha256_vjob;
+ uint8_t cached[32];
+
+ job->segs = segs;
+ job->num_segs = num_segs;
+ job->next = 0;
+ job->running = 0;
+ job->fail = num_segs;
+ job->priority = priority;
+ job->deadline = (deadline_ms > 0) ? local_NowNs() + deadline_ms * 1000000 : UINT64_MAX;
+ job->done = false;
+
+ //-- segments found in cache are done, or failed if end hash differs
+ //-- segments with infusion schedule not ascending failed, schedule shared by segments checked 1x
+ const rsha256_infusion* checked = NULL;
+ uint32_t checked_num = 0;
+ job->todo.reserve(num_segs);
+ for(uint32_t i = 0; i < num_segs; ++i){
+   if(segs[i].num_infusions > 0 && (segs[i].infusions != checked || segs[i].num_infusions != checked_num)){
+     if(!local_InfusionValid(&segs[i])){ local_JobFail(job,i); continue; }
+     checked = segs[i].infusions;
+     checked_num = segs[i].num_infusions;
+     }
+   if(engine->cache != NULL && segs[i].num_infusions == 0 && rsha256_vcache_lookup(engine->cache,segs[i].start,segs[i].iters,cached)){
+     if(memcmp(cached,segs[i].end,32)){ local_JobFail(job,i); }
+     continue;
+     }
+   job->todo.push_back(i);
+   }
+
+ {
+ std::lock_guard<std::mutex> guard(engine->lock);
+ job->order = engine->order++;
+ engine->jobs.push_back(job);
+ local_JobCheckDone(engine,job);
+ engine->submits.fetch_add(1);
+ }
+ engine->wake.notify_all();
+ return job;
+}
+
+//-- rsha256_vengine_done() - true if job finished, result available without wait
+bool rsha256_vengine_done(
+rsha256_vengine* engine,
+rsha256_vjob*    job)
+{
+ std::lock_guard<std::mutex> guard(engine->lock);
+ return job->done;
+}
+
+//-- rsha256_vengine_wait() - wait for job, return index of first failing segment, free job
+uint32_t rsha256_vengine_wait(
+rsha256_vengine* engine,
+rsha256_vjob*    job)
+{
+ uint32_t fail;
+ {
+ std::unique_lock<std::mutex> lk(engine->lock);
+ engine->finished.wait(lk,[job]{ return job->done; });
+ fail = job->fail;
+ }
+ delete job;
+ return fail;
+}
+
+//-- rsha256_verify_segs() - verify segments, 1x job on engine of its own
+uint32_t rsha256_verify_segs(
+const rsha256_vseg* segs,
+const uint32_t      num_segs,
+const uint32_t      threads,
+rsha256_vcache*     cache)
+{
+ //-- no more threads than lanes to fill
+ rsha256_cpubudget budget;
+ if(threads == 0) rsha256_cpu_budget(&budget,1.0);
+ uint32_t nthreads = (threads > 0) ? threads : budget.threads;
+ uint32_t nneeded = (num_segs + RSHA256PL_VERIFY_LANES - 1) / RSHA256PL_VERIFY_LANES;
+ if(nthreads > nneeded) nthreads = nneeded;
+ if(nthreads < 1) nthreads = 1;
+
+ rsha256_vengine* engine = rsha256_vengine_create(nthreads,cache);
+ if(threads == 0 && budget.duty < 1.0) rsha256_vengine_budget(engine,1.0);
+ uint32_t fail = rsha256_vengine_wait(engine,rsha256_vengine_submit(engine,segs,num_segs,0,0));
+ rsha256_vengine_destroy(engine);
+ return fail;
+}
+
+//-- rsha256_verify() - verify chain of checkpoints, segment i from checkpoint i-1 (or start) to i
+bool rsha256_verify(
+const uint8_t*  start_hash,
+const uint8_t*  cp_hashes,
+const uint32_t  num_cps,
+const uint64_t  cp_iters,
+uint32_t*       fail_cp,
+const uint32_t  threads,
+rsha256_vcache* cache)
+{
+ std::vector<rsha256_vseg> segs(num_cps);
+ for(uint32_t i = 0; i < num_cps; ++i){
+   segs[i].start = (i == 0) ? start_hash : &cp_hashes[32 * (i - 1)];
+   segs[i].end = &cp_hashes[32 * i];
+   segs[i].iters = cp_iters;
+   }
+
+ uint32_t fail = rsha256_verify_segs(segs.data(),num_cps,threads,cache);
+ if(fail_cp != NULL) *fail_cp = fail;
+ return (fail == num_cps);
+}
+
+//-- rsha256_verify_infused() - verify chain of checkpoints with infusions, same segments as rsha256_verify()
+bool rsha256_verify_infused(
+const uint8_t*          start_hash,
+const uint8_t*          cp_hashes,
+const uint32_t          num_cps,
+const uint64_t          cp_iters,
+const rsha256_infusion* infusions,
+const uint32_t          num_infusions,
+uint32_t*               fail_cp,
+const uint32_t          threads)
+{
+ std::vector<rsha256_vseg> segs(num_cps);
+ for(uint32_t i = 0; i < num_cps; ++i){
+   segs[i].start = (i == 0) ? start_hash : &cp_hashes[32 * (i - 1)];
+   segs[i].end = &cp_hashes[32 * i];
+   segs[i].iters = cp_iters;
+   segs[i].infusions = infusions;
+   segs[i].num_infusions = num_infusions;
+   segs[i].start_iters = (uint64_t)i * cp_iters;
+   }
+
+ uint32_t fail = rsha256_verify_segs(segs.data(),num_cps,threads,NULL);
+ if(fail_cp != NULL) *fail_cp = fail;
+ return (fail == num_cps);
+}
+
+// <eof>
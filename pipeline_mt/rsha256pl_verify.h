@@ -0,0 +1,324 @@
+/*
+ * File: rsha256pl_verify.h
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Declarations for VDF verification with pipelined fast recursive SHA256
+ *
+ * rsha256pl_fast_*.cxx   - Pipelined editions, from x1 to x4
+ * rsha256pl_verify.cxx   - Verify segments/checkpoints, multithreaded
+ * rsha256pl_vcache.cxx   - Cache of already verified segments
+ * rsha256pl_pair_*.cxx   - SHA256 of 64 bytes (left||right), multi-buffer
+ * rsha256pl_batch_*.cxx  - SHA256 of N messages (any length), multi-buffer
+ * rsha256pl_chains.cxx   - Bulk of independent chains, in place, multithreaded
+ * rsha256pl_merkle.cxx   - Merkle commitment over checkpoints, spot-check verify
+ * rsha256pl_budget.cxx   - CPU budget of process (affinity, cgroup quota)
+ * rsha256pl_locate.cxx   - Locate first bad iteration in a failing segment
+ * rsha256pl_vnet.cxx     - Verify on several hosts, coordinator/workers over TCP
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#ifndef RSHA256PL_VERIFY_H
+#define RSHA256PL_VERIFY_H
+
+#include <stdint.h>
+
+//-- pipelined recursive SHA256 (rsha256pl_fast_*.cxx)
+void rsha256_fast_x1(uint8_t* hash, const uint64_t num_iters);
+void rsha256_fast_x2(uint8_t* hash, const uint64_t num_iters);
+void rsha256_fast_x3(uint8_t* hash, const uint64_t num_iters);
+void rsha256_fast_x4(uint8_t* hash, const uint64_t num_iters);
+
+//-- external data infused into chain, iteration is SHA256(hash||data) instead of SHA256(hash)
+#ifndef RSHA256_INFUSION_DEFINED
+#define RSHA256_INFUSION_DEFINED
+struct rsha256_infusion {
+ uint64_t iter;                //-- iteration of chain (1 = first after chain start) computed as SHA256(hash||data)
+ uint8_t  data[32];            //-- 32bytes data, 2nd half of 64bytes message
+ };
+#endif
+
+//-- 1x segment of a VDF, number of iterations from start hash to end hash
+struct rsha256_vseg {
+ const uint8_t*          start;          //-- 32bytes hash/data at start of segment
+ const uint8_t*          end;            //-- 32bytes hash/data expected at end of segment
+ uint64_t                iters;          //-- number of SHA256 iterations from start to end
+ const rsha256_infusion* infusions;      //-- infusion schedule of chain, ascending by iteration, 1x per iteration, else segment fails (optional, NULL)
+ uint32_t                num_infusions;  //-- number of infusions in *infusions
+ uint64_t                start_iters;    //-- iteration of chain at start hash, only used with infusions
+ };
+
+//-- cache of verified segments, (start hash, iterations) -> end hash (rsha256pl_vcache.cxx)
+struct rsha256_vcache;
+
+rsha256_vcache* rsha256_vcache_create( //-- return new cache, NULL if failed
+const uint32_t max_entries);           //-- max number of segments kept in cache (rounded down)
+
+void rsha256_vcache_destroy(
+rsha256_vcache* cache);
+
+bool rsha256_vcache_lookup(  //-- return true if segment found, end hash to *end
+rsha256_vcache* cache,
+const uint8_t*  start,       //-- 32bytes hash/data at start of segment
+const uint64_t  iters,       //-- number of SHA256 iterations in segment
+uint8_t*        end);        //-- output 32bytes hash/data at end of segment
+
+void rsha256_vcache_insert(
+rsha256_vcache* cache,
+const uint8_t*  start,       //-- 32bytes hash/data at start of segment
+const uint64_t  iters,       //-- number of SHA256 iterations in segment
+const uint8_t*  end);        //-- 32bytes verified hash/data at end of segment
+
+void rsha256_vcache_stats(
+rsha256_vcache* cache,
+uint64_t*       hits,        //-- output number of lookups found (optional, NULL)
+uint64_t*       misses,      //-- output number of lookups not found (optional, NULL)
+uint32_t*       entries);    //-- output number of segments in cache (optional, NULL)
+
+//-- CPU budget of process, affinity and cgroup v2 quota (rsha256pl_budget.cxx)
+struct rsha256_cpubudget {
+ uint32_t cpus;              //-- logical CPUs online
+ uint32_t cpus_affinity;     //-- logical CPUs process may run on (affinity mask)
+ double   cpus_quota;        //-- CPUs of cgroup v2 quota (cpu.max), 0.0 if no limit
+ double   cpus_budget;       //-- CPUs to use, min(affinity, quota) x fraction
+ uint32_t threads;           //-- threads to use for budget, rounded up
+ double   duty;              //-- duty cycle per thread (0.0-1.0), threads x duty = budget
+ };
+
+void rsha256_cpu_budget(     //-- no return value, result to *budget
+rsha256_cpubudget* budget,   //-- output CPU budget of process
+const double       fraction); //-- fraction of available CPUs to use (0.0-1.0), 1.0 = all
+
+//-- engine, worker threads and queue of jobs by priority/deadline (rsha256pl_verify.cxx)
+struct rsha256_vengine;
+struct rsha256_vjob;
+
+rsha256_vengine* rsha256_vengine_create( //-- return new engine, worker threads started
+const uint32_t  threads,        //-- number of worker threads, 0 = by CPU budget (with duty cycle)
+rsha256_vcache* cache);         //-- cache of verified segments (optional, NULL)
+
+uint32_t rsha256_vengine_budget( //-- return number of active worker threads, rest idle
+rsha256_vengine* engine,
+const double     fraction);     //-- fraction of CPU budget to use (0.0-1.0), duty cycle at chunk boundaries
+
+void rsha256_vengine_destroy(   //-- finish queued jobs, stop worker threads, free engine
+rsha256_vengine* engine);
+
+rsha256_vjob* rsha256_vengine_submit( //-- return job, *segs must stay valid until rsha256_vengine_wait()
+rsha256_vengine*    engine,
+const rsha256_vseg* segs,       //-- array of segments to verify
+const uint32_t      num_segs,   //-- number of segments in *segs
+const int32_t       priority,   //-- higher first (tip of chain), preempts lower at chunk boundaries
+const uint64_t      deadline_ms); //-- earlier first within same priority, ms from now, 0 = none
+
+bool rsha256_vengine_done(      //-- return true if job finished (rsha256_vengine_wait() will not block)
+rsha256_vengine* engine,
+rsha256_vjob*    job);
+
+uint32_t rsha256_vengine_wait(  //-- return index of first failing segment, num_segs if all ok, job freed
+rsha256_vengine* engine,
+rsha256_vjob*    job);
+
+//-- verify VDF segments/checkpoints, multithreaded, engine of its own (rsha256pl_verify.cxx)
+uint32_t rsha256_verify_segs(   //-- return index of first failing segment, num_segs if all ok
+const rsha256_vseg* segs,       //-- array of segments to verify
+const uint32_t      num_segs,   //-- number of segments in *segs
+const uint32_t      threads,    //-- number of threads to use, 0 = by CPU budget
+rsha256_vcache*     cache);     //-- cache of verified segments (optional, NULL)
+
+bool rsha256_verify(            //-- return true if all checkpoints verified ok
+const uint8_t*  start_hash,     //-- 32bytes hash/data at iteration 0
+const uint8_t*  cp_hashes,      //-- num_cps x 32bytes checkpoint hash/data values
+const uint32_t  num_cps,        //-- number of checkpoints in *cp_hashes
+const uint64_t  cp_iters,       //-- number of SHA256 iterations between checkpoints
+uint32_t*       fail_cp,        //-- output index of first failing checkpoint (optional, NULL)
+const uint32_t  threads,        //-- number of threads to use, 0 = by CPU budget
+rsha256_vcache* cache);         //-- cache of verified segments (optional, NULL)
+
+bool rsha256_verify_infused(    //-- return true if all checkpoints verified ok, chain with infusions
+const uint8_t*          start_hash,    //-- 32bytes hash/data at iteration 0
+const uint8_t*          cp_hashes,     //-- num_cps x 32bytes checkpoint hash/data values
+const uint32_t          num_cps,       //-- number of checkpoints in *cp_hashes
+const uint64_t          cp_iters,      //-- number of iterations between checkpoints (infusions included)
+const rsha256_infusion* infusions,     //-- infusion schedule, ascending by iteration, 1x per iteration
+const uint32_t          num_infusions, //-- number of infusions in *infusions
+uint32_t*               fail_cp,       //-- output index of first failing checkpoint (optional, NULL)
+const uint32_t          threads);      //-- number of threads to use, 0 = by CPU budget
+
+//-- creator hash/data at largest iteration it has, at or below iter, return that iteration (0 if none)
+typedef uint64_t (*rsha256_locfunc)(void* ctx, const uint64_t iter, uint8_t* hash);
+
+//-- array of sub-checkpoints, hash/data i at iteration (i + 1) x sub_iters, for rsha256_locate_subcps()
+struct rsha256_subcps {
+ const uint8_t* hashes;      //-- num x 32bytes sub-checkpoint hash/data values
+ uint64_t       num;         //-- number of sub-checkpoints in *hashes
+ uint64_t       sub_iters;   //-- number of SHA256 iterations between sub-checkpoints
+ };
+
+//-- locate first bad iteration in a failing segment (rsha256pl_locate.cxx)
+uint64_t rsha256_locate_record( //-- return number of sub-checkpoints, ceil(iters / sub_iters)
+uint8_t*       sub_hashes,      //-- output sub-checkpoint hash/data values, every sub_iters (last at iters)
+const uint8_t* start,           //-- 32bytes hash/data at start of segment
+const uint64_t iters,           //-- number of SHA256 iterations in segment
+const uint64_t sub_iters);      //-- number of SHA256 iterations between sub-checkpoints
+
+uint64_t rsha256_locate_subcps( //-- rsha256_locfunc for array of sub-checkpoints, ctx is rsha256_subcps*
+void*          ctx,
+const uint64_t iter,
+uint8_t*       hash);
+
+bool rsha256_locate(            //-- return true if segment bad, first bad iteration in (*good_iter, *bad_iter]
+uint64_t*       good_iter,      //-- output last iteration where creator hash/data verified ok
+uint64_t*       bad_iter,       //-- output first iteration where creator hash/data verified bad
+const uint8_t*  start,          //-- 32bytes hash/data at start of segment (known ok)
+const uint8_t*  end,            //-- 32bytes creator hash/data at end of segment
+const uint64_t  iters,          //-- number of SHA256 iterations in segment
+rsha256_locfunc func,           //-- creator hash/data inside segment (optional, NULL)
+void*           ctx,            //-- context given to func
+const uint32_t  ways,           //-- number of sub-ranges per round (k), 0 = 2 x threads
+const uint32_t  threads);       //-- number of threads to use, 0 = by CPU budget
+
+//-- verify on several hosts, coordinator/workers over TCP (rsha256pl_vnet.cxx)
+int rsha256_vnet_listen(        //-- return listening socket, -1 if failed
+const char*    addr,            //-- address to listen on, NULL = all
+const uint16_t port);           //-- port to listen on, 0 = any free port
+
+uint16_t rsha256_vnet_port(     //-- return port of listening socket
+const int listen_fd);
+
+void rsha256_vnet_serve(        //-- worker, verify tasks from coordinators, until rsha256_vnet_stop()
+const int       listen_fd,      //-- listening socket from rsha256_vnet_listen()
+const uint32_t  threads,        //-- number of worker threads, 0 = by CPU budget
+rsha256_vcache* cache);         //-- cache of verified segments (optional, NULL)
+
+void rsha256_vnet_stop(         //-- stop rsha256_vnet_serve(), from other thread
+const int listen_fd);
+
+uint32_t rsha256_vnet_verify(   //-- return index of first failing segment, num_segs if all ok
+const rsha256_vseg* segs,       //-- array of segments to verify
+const uint32_t      num_segs,   //-- number of segments in *segs
+const char* const*  workers,    //-- array of worker addresses, "host:port"
+const uint32_t      num_workers, //-- number of workers in *workers
+const uint64_t      straggler_ms, //-- resend task in flight longer to idle worker, 0 = 2x average task
+const uint32_t      threads);   //-- number of threads to verify locally, segments with infusions or if all workers lost
+
+//-- SHA256 of 64 bytes (left||right pair), multi-buffer (rsha256pl_pair_*.cxx)
+void rsha256_pair(           //-- no return value, result to *out
+uint8_t*       out,          //-- output num_pairs x 32bytes SHA256 values (may be same as *in)
+const uint8_t* in,           //-- input num_pairs x 64bytes data (left||right 32bytes hashes)
+const uint64_t num_pairs);   //-- number of 64bytes to SHA256
+
+//-- same as rsha256_pair(), fixed number of pairs pipelined, x1 to x4 (rsha256pl_pair_*.cxx)
+void rsha256_pair_x1(uint8_t* out, const uint8_t* in, const uint64_t num_pairs);
+void rsha256_pair_x2(uint8_t* out, const uint8_t* in, const uint64_t num_pairs);
+void rsha256_pair_x3(uint8_t* out, const uint8_t* in, const uint64_t num_pairs);
+void rsha256_pair_x4(uint8_t* out, const uint8_t* in, const uint64_t num_pairs);
+
+//-- SHA256 of N messages (any length), grouped by number of blocks, multi-buffer (rsha256pl_batch_*.cxx)
+void rsha256_batch(             //-- no return value, results to *out
+uint8_t*              out,      //-- output num_msgs x 32bytes SHA256 values, same order as *msgs
+const uint8_t* const* msgs,     //-- input num_msgs pointers to messages
+const uint64_t*       lens,     //-- input num_msgs lengths of messages, bytes
+const uint32_t        num_msgs, //-- number of messages to SHA256
+const uint32_t        lanes);   //-- messages pipelined per core, 1 to 4, 0 = default (x2)
+
+//-- bulk of independent chains in place, lanes on all threads (rsha256pl_chains.cxx)
+void rsha256_chains(            //-- no return value, results to *hashes (in place)
+uint8_t*        hashes,         //-- input/output num_chains x 32bytes, start hash/data in, end hash/data out
+const uint64_t* iters,          //-- number of SHA256 iterations per chain (optional, NULL = num_iters for all)
+const uint64_t  num_iters,      //-- number of SHA256 iterations of all chains, if *iters is NULL
+const uint64_t  num_chains,     //-- number of chains in *hashes
+const uint32_t  lanes,          //-- chains pipelined per thread, 1 to 4, 0 = default (x2)
+const uint32_t  threads);       //-- number of threads to use, 0 = by CPU budget
+
+//-- spot-check proof of 1x segment, checkpoints with Merkle paths (max 32 levels)
+struct rsha256_spot {
+ uint32_t seg;               //-- index of segment, from checkpoint seg - 1 (or start hash) to seg
+ uint32_t start_len;         //-- number of hashes in *start_path (0 if seg is 0)
+ uint32_t end_len;           //-- number of hashes in *end_path
+ uint8_t  start[32];         //-- hash/data at start of segment
+ uint8_t  end[32];           //-- hash/data at end of segment
+ uint8_t  start_path[32 * 32];
+ uint8_t  end_path[32 * 32];
+ };
+
+//-- Merkle commitment over checkpoints, spot-check verify (rsha256pl_merkle.cxx)
+uint64_t rsha256_merkle_size(   //-- return number of 32bytes nodes in tree, all levels
+const uint32_t num_leaves);
+
+void rsha256_merkle_build(      //-- no return value, all levels to *tree, root is last node
+uint8_t*       tree,            //-- output rsha256_merkle_size() x 32bytes
+const uint8_t* leaves,          //-- num_leaves x 32bytes hash/data values
+const uint32_t num_leaves);
+
+void rsha256_merkle_root(       //-- no return value, result to *root
+uint8_t*       root,            //-- output 32bytes Merkle root
+const uint8_t* leaves,          //-- num_leaves x 32bytes hash/data values
+const uint32_t num_leaves);
+
+uint32_t rsha256_merkle_path(   //-- return number of 32bytes hashes in *path
+uint8_t*       path,            //-- output max 32 x 32bytes sibling hashes, leaf to root
+const uint8_t* tree,            //-- all levels from rsha256_merkle_build()
+const uint32_t num_leaves,
+const uint32_t index);          //-- index of leaf
+
+bool rsha256_merkle_check(      //-- return true if leaf, with path, leads to root
+const uint8_t* root,
+const uint8_t* leaf,
+const uint32_t num_leaves,
+const uint32_t index,
+const uint8_t* path,
+const uint32_t path_len);
+
+//-- streaming Merkle root, leaves added as they come, bounded memory (rsha256pl_merkle.cxx)
+struct rsha256_mstream;
+
+rsha256_mstream* rsha256_mstream_create(void); //-- return new stream, no leaves
+
+void rsha256_mstream_add(       //-- no return value, leaves appended to stream
+rsha256_mstream* stream,
+const uint8_t*   leaves,        //-- num_leaves x 32bytes hash/data values
+const uint64_t   num_leaves);
+
+uint64_t rsha256_mstream_root(  //-- return number of leaves, stream is finished (only destroy after)
+rsha256_mstream* stream,
+uint8_t*         root);         //-- output 32bytes Merkle root, same as rsha256_merkle_root()
+
+void rsha256_mstream_destroy(
+rsha256_mstream* stream);
+
+uint32_t rsha256_spot_select(   //-- return number of segments selected, min(num_spots, num_cps)
+uint32_t*      segs,            //-- output sorted distinct segment indexes
+const uint32_t num_spots,       //-- number of segments to select
+const uint8_t* root,            //-- 32bytes Merkle root over checkpoints
+const uint8_t* start_hash,      //-- 32bytes hash/data at iteration 0
+const uint32_t num_cps,         //-- number of checkpoints
+const uint64_t cp_iters);       //-- number of SHA256 iterations between checkpoints
+
+uint32_t rsha256_spot_prove(    //-- return number of spot proofs in *spots
+rsha256_spot*  spots,           //-- output num_spots spot proofs
+const uint32_t num_spots,       //-- number of segments to select
+uint8_t*       root,            //-- output 32bytes Merkle root over checkpoints
+const uint8_t* start_hash,      //-- 32bytes hash/data at iteration 0
+const uint8_t* cp_hashes,       //-- num_cps x 32bytes checkpoint hash/data values
+const uint32_t num_cps,         //-- number of checkpoints in *cp_hashes
+const uint64_t cp_iters);       //-- number of SHA256 iterations between checkpoints
+
+bool rsha256_spot_verify(       //-- return true if selection, Merkle paths and segments verified ok
+const uint8_t*      root,       //-- 32bytes Merkle root over checkpoints
+const uint8_t*      start_hash, //-- 32bytes hash/data at iteration 0
+const uint32_t      num_cps,    //-- number of checkpoints
+const uint64_t      cp_iters,   //-- number of SHA256 iterations between checkpoints
+const rsha256_spot* spots,      //-- spot proofs from rsha256_spot_prove()
+const uint32_t      num_spots,  //-- num_spots given to rsha256_spot_prove(), min(num_spots, num_cps) proofs in *spots
+const uint32_t      threads,    //-- number of threads to use, 0 = by CPU budget
+rsha256_vcache*     cache);     //-- cache of verified segments (optional, NULL)
+
+#endif
+
+// <eof>
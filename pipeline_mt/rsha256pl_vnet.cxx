@@ -0,0 +1,591 @@
+/*
+ * File: rsha256pl_vnet.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Verify VDF segments on several hosts, coordinator and workers over TCP
+ *
+ * rsha256_vnet_serve()  - Worker, verify tasks on local engine (rsha256pl_verify.cxx)
+ * rsha256_vnet_verify() - Coordinator, split segments in tasks across workers
+ *
+ * Coordinator keeps 2x lanes of segments in flight per worker, results are
+ * streamed back per task. Task of a lost worker goes back to queue. Task in
+ * flight longer than straggler time is sent to an idle worker as well, first
+ * result wins. Tasks left if all workers lost, are verified locally.
+ *
+ * Protocol, frames of u32 length (type + payload), u8 type, payload (little-endian):
+ *   HELLO  (worker)      - u32 threads
+ *   TASK   (coordinator) - u64 id, u32 count, count x (32bytes start, 32bytes end, u64 iters)
+ *   RESULT (worker)      - u64 id, u32 index of first failing segment in task, count if all ok
+ *
+ * Workers are trusted (own hosts), no authentication or encryption.
+ * Segments with infusions are not sent, verified locally by coordinator
+ * in parallel with workers, rest of segments sent.
+ *
+ * Requirement: POSIX sockets (Linux, macOS), rsha256pl_verify.cxx
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rsha256pl_verify.h"
+
+#if !defined(_WIN32)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+//-- frame types, max frame length
+#define VNET_HELLO  0
+#define VNET_TASK   1
+#define VNET_RESULT 2
+#define VNET_MAXLEN (16 * 1024 * 1024)
+
+//-- segments per task, default
+#ifndef RSHA256PL_VNET_BATCH
+#define RSHA256PL_VNET_BATCH 4
+#endif
+
+//-- local_Put32/Put64/Get32/Get64() - little-endian values in frames
+static inline void local_Put32(uint8_t* p,uint32_t v){ for(uint32_t i = 0; i < 4; ++i){ p[i] = (uint8_t)(v >> (8 * i)); } }
+static inline void local_Put64(uint8_t* p,uint64_t v){ for(uint32_t i = 0; i < 8; ++i){ p[i] = (uint8_t)(v >> (8 * i)); } }
+static inline uint32_t local_Get32(const uint8_t* p){ uint32_t v = 0; for(uint32_t i = 0; i < 4; ++i){ v |= (uint32_t)p[i] << (8 * i); } return v; }
+static inline uint64_t local_Get64(const uint8_t* p){ uint64_t v = 0; for(uint32_t i = 0; i < 8; ++i){ v |= (uint64_t)p[i] << (8 * i); } return v; }
+
+//-- local_NowNs() - monotonic time in nanoseconds
+static inline uint64_t local_NowNs()
+{
+ return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//-- local_SendAll() - send whole buffer, false if connection lost
+static bool local_SendAll(int fd,const uint8_t* buf,size_t len)
+{
+ while(len > 0){
+   ssize_t n = send(fd,buf,len,MSG_NOSIGNAL);
+   if(n < 0 && errno == EINTR) continue;
+   if(n <= 0) return false;
+   buf += n;
+   len -= (size_t)n;
+   }
+ return true;
+}
+
+//-- local_RecvAll() - receive whole buffer, false if connection lost
+static bool local_RecvAll(int fd,uint8_t* buf,size_t len)
+{
+ while(len > 0){
+   ssize_t n = recv(fd,buf,len,0);
+   if(n < 0 && errno == EINTR) continue;
+   if(n <= 0) return false;
+   buf += n;
+   len -= (size_t)n;
+   }
+ return true;
+}
+
+//-- local_SendFrame() - frame of type and payload
+static bool local_SendFrame(int fd,uint8_t type,const uint8_t* payload,uint32_t len)
+{
+ std::vector<uint8_t> frame(5 + (size_t)len);
+ local_Put32(&frame[0],len + 1);
+ frame[4] = type;
+ if(len > 0) memcpy(&frame[5],payload,len);
+ return local_SendAll(fd,frame.data(),frame.size());
+}
+
+//-- local_SetupSocket() - no delay of small frames, no SIGPIPE where flag exists
+static void local_SetupSocket(int fd)
+{
+ int one = 1;
+ setsockopt(fd,IPPROTO_TCP,TCP_NODELAY,&one,sizeof(one));
+#ifdef SO_NOSIGPIPE
+ setsockopt(fd,SOL_SOCKET,SO_NOSIGPIPE,&one,sizeof(one));
+#endif
+}
+
+//-- rsha256_vnet_listen() - listening socket on addr:port, port 0 = any free port
+int rsha256_vnet_listen(
+const char*    addr,
+const uint16_t port)
+{
+ struct addrinfo hints;
+ struct addrinfo* res = NULL;
+ char portstr[8];
+ memset(&hints,0,sizeof(hints));
+ hints.ai_family = AF_UNSPEC;
+ hints.ai_socktype = SOCK_STREAM;
+ hints.ai_flags = AI_PASSIVE;
+ snprintf(portstr,sizeof(portstr),"%u",(unsigned)port);
+ if(getaddrinfo(addr,portstr,&hints,&res) != 0) return -1;
+
+ int fd = -1;
+ for(struct addrinfo* ai = res; ai != NULL; ai = ai->ai_next){
+   fd = socket(ai->ai_family,ai->ai_socktype,ai->ai_protocol);
+   if(fd < 0) continue;
+   int one = 1;
+   setsockopt(fd,SOL_SOCKET,SO_REUSEADDR,&one,sizeof(one));
+   if(bind(fd,ai->ai_addr,ai->ai_addrlen) == 0 && listen(fd,64) == 0) break;
+   close(fd);
+   fd = -1;
+   }
+ freeaddrinfo(res);
+ return fd;
+}
+
+//-- rsha256_vnet_port() - port of listening socket (after port 0)
+uint16_t rsha256_vnet_port(
+const int listen_fd)
+{
+ struct sockaddr_storage ss;
+ socklen_t len = sizeof(ss);
+ if(getsockname(listen_fd,(struct sockaddr*)&ss,&len) != 0) return 0;
+ if(ss.ss_family == AF_INET) return ntohs(((struct sockaddr_in*)&ss)->sin_port);
+ if(ss.ss_family == AF_INET6) return ntohs(((struct sockaddr_in6*)&ss)->sin6_port);
+ return 0;
+}
+
+//-- rsha256_vnet_stop() - stop rsha256_vnet_serve() on listening socket, from other thread
+void rsha256_vnet_stop(
+const int listen_fd)
+{
+ shutdown(listen_fd,SHUT_RDWR);
+}
+
+//-- worker, 1x task from coordinator, segments point into data
+struct local_wtask {
+ uint64_t                  id;
+ uint32_t                  count;
+ std::vector<uint8_t>      data;
+ std::vector<rsha256_vseg> segs;
+ rsha256_vjob*             job;
+ };
+
+//-- worker, 1x connection, reader submits tasks, writer waits in order and sends results
+struct local_wconn {
+ int                      fd;
+ std::mutex               lock;
+ std::condition_variable  ready;
+ std::deque<local_wtask*> queue;
+ bool                     eof;
+ };
+
+//-- local_WorkerWriter() - wait for tasks in order, send results
+static void local_WorkerWriter(rsha256_vengine* engine,local_wconn* conn)
+{
+ bool alive = true;
+ uint8_t payload[12];
+ for(;;){
+   local_wtask* task;
+   {
+   std::unique_lock<std::mutex> lk(conn->lock);
+   conn->ready.wait(lk,[conn]{ return (!conn->queue.empty() || conn->eof); });
+   if(conn->queue.empty()) return;
+   task = conn->queue.front();
+   conn->queue.pop_front();
+   }
+   uint32_t fail = rsha256_vengine_wait(engine,task->job);
+   local_Put64(&payload[0],task->id);
+   local_Put32(&payload[8],fail);
+   if(alive) alive = local_SendFrame(conn->fd,VNET_RESULT,payload,12);
+   if(!alive) shutdown(conn->fd,SHUT_RDWR);
+   delete task;
+   }
+}
+
+//-- worker, open connections, shut down when stopped
+struct local_wserve {
+ std::mutex       lock;
+ std::vector<int> fds;
+ };
+
+//-- local_WorkerConn() - 1x coordinator connection, until closed
+static void local_WorkerConn(rsha256_vengine* engine,const uint32_t threads,local_wserve* serve,int fd)
+{
+ local_wconn conn;
+ conn.fd = fd;
+ conn.eof = false;
+ local_SetupSocket(fd);
+
+ uint8_t hello[4];
+ local_Put32(hello,threads);
+ std::thread writer(local_WorkerWriter,engine,&conn);
+
+ bool alive = local_SendFrame(fd,VNET_HELLO,hello,4);
+ while(alive){
+   uint8_t head[5];
+   if(!local_RecvAll(fd,head,5)) break;
+   uint32_t len = local_Get32(head);
+   if(len < 1 || len > VNET_MAXLEN) break;
+   std::vector<uint8_t> payload(len - 1);
+   if(!local_RecvAll(fd,payload.data(),payload.size())) break;
+   if(head[4] != VNET_TASK) continue;
+   if(payload.size() < 12) break;
+
+   local_wtask* task = new local_wtask;
+   task->id = local_Get64(&payload[0]);
+   task->count = local_Get32(&payload[8]);
+   if(payload.size() != 12 + (size_t)task->count * 72){ delete task; break; }
+   task->data.assign(payload.begin() + 12,payload.end());
+   task->segs.resize(task->count);
+   for(uint32_t i = 0; i < task->count; ++i){
+     const uint8_t* seg = &task->data[72 * i];
+     task->segs[i].start = &seg[0];
+     task->segs[i].end = &seg[32];
+     task->segs[i].iters = local_Get64(&seg[64]);
+     }
+   task->job = rsha256_vengine_submit(engine,task->segs.data(),task->count,0,0);
+   {
+   std::lock_guard<std::mutex> guard(conn.lock);
+   conn.queue.push_back(task);
+   }
+   conn.ready.notify_one();
+   }
+
+ {
+ std::lock_guard<std::mutex> guard(conn.lock);
+ conn.eof = true;
+ }
+ conn.ready.notify_one();
+ writer.join();
+
+ {
+ std::lock_guard<std::mutex> guard(serve->lock);
+ for(size_t i = 0; i < serve->fds.size(); ++i){
+   if(serve->fds[i] == fd){ serve->fds[i] = serve->fds.back(); serve->fds.pop_back(); break; }
+   }
+ close(fd);
+ }
+}
+
+//-- rsha256_vnet_serve() - worker, accept coordinators, verify tasks on local engine, until stopped
+void rsha256_vnet_serve(
+const int       listen_fd,
+const uint32_t  threads,
+rsha256_vcache* cache)
+{
+ rsha256_vengine* engine = rsha256_vengine_create(threads,cache);
+ uint32_t nthreads = threads;
+ if(nthreads == 0){
+   rsha256_cpubudget budget;
+   rsha256_cpu_budget(&budget,1.0);
+   nthreads = budget.threads;
+   }
+
+ std::vector<std::thread> conns;
+ local_wserve serve;
+ for(;;){
+   int fd = accept(listen_fd,NULL,NULL);
+   if(fd < 0){
+     if(errno == EINTR || errno == ECONNABORTED) continue;
+     break;
+     }
+   {
+   std::lock_guard<std::mutex> guard(serve.lock);
+   serve.fds.push_back(fd);
+   }
+   conns.emplace_back(local_WorkerConn,engine,nthreads,&serve,fd);
+   }
+
+ //-- stopped, shut down connections still open
+ {
+ std::lock_guard<std::mutex> guard(serve.lock);
+ for(int fd : serve.fds){ shutdown(fd,SHUT_RDWR); }
+ }
+ for(std::thread& conn : conns){ conn.join(); }
+ rsha256_vengine_destroy(engine);
+}
+
+//-- coordinator, 1x task, segments first to first + count
+struct local_ctask {
+ uint32_t first;
+ uint32_t count;
+ uint32_t active;
+ uint32_t sends;
+ uint64_t sent;
+ bool     done;
+ };
+
+//-- coordinator, 1x worker connection
+struct local_cpeer {
+ int                   fd;
+ bool                  alive;
+ uint32_t              window;
+ uint32_t              inflight;
+ std::vector<uint32_t> tasks;
+ std::vector<uint8_t>  rbuf;
+ };
+
+//-- local_Connect() - connect to host:port, -1 if failed
+static int local_Connect(const char* worker)
+{
+ std::string host = worker;
+ std::string port = "0";
+ size_t colon = host.find_last_of(':');
+ if(colon != std::string::npos){ port = host.substr(colon + 1); host = host.substr(0,colon); }
+ if(host.size() > 2 && host.front() == '[' && host.back() == ']') host = host.substr(1,host.size() - 2);
+
+ struct addrinfo hints;
+ struct addrinfo* res = NULL;
+ memset(&hints,0,sizeof(hints));
+ hints.ai_family = AF_UNSPEC;
+ hints.ai_socktype = SOCK_STREAM;
+ if(getaddrinfo(host.c_str(),port.c_str(),&hints,&res) != 0) return -1;
+
+ int fd = -1;
+ for(struct addrinfo* ai = res; ai != NULL; ai = ai->ai_next){
+   fd = socket(ai->ai_family,ai->ai_socktype,ai->ai_protocol);
+   if(fd < 0) continue;
+   if(connect(fd,ai->ai_addr,ai->ai_addrlen) == 0) break;
+   close(fd);
+   fd = -1;
+   }
+ freeaddrinfo(res);
+ if(fd >= 0) local_SetupSocket(fd);
+ return fd;
+}
+
+//-- local_PeerLost() - close worker, its tasks back to queue if no other worker runs them
+static void local_PeerLost(local_cpeer* peer,std::vector<local_ctask>& tasks,uint32_t* nextpending)
+{
+ if(!peer->alive) return;
+ peer->alive = false;
+ close(peer->fd);
+ for(uint32_t t : peer->tasks){
+   --tasks[t].active;
+   if(tasks[t].active == 0 && !tasks[t].done && t < *nextpending) *nextpending = t;
+   }
+ peer->tasks.clear();
+ peer->inflight = 0;
+}
+
+//-- local_SendTask() - task of segments to worker
+static bool local_SendTask(local_cpeer* peer,const rsha256_vseg* segs,uint32_t t,local_ctask* task)
+{
+ std::vector<uint8_t> payload(12 + (size_t)task->count * 72);
+ local_Put64(&payload[0],t);
+ local_Put32(&payload[8],task->count);
+ for(uint32_t i = 0; i < task->count; ++i){
+   const rsha256_vseg* seg = &segs[task->first + i];
+   uint8_t* p = &payload[12 + 72 * (size_t)i];
+   memcpy(&p[0],seg->start,32);
+   memcpy(&p[32],seg->end,32);
+   local_Put64(&p[64],seg->iters);
+   }
+ return local_SendFrame(peer->fd,VNET_TASK,payload.data(),(uint32_t)payload.size());
+}
+
+//-- rsha256_vnet_verify() - coordinator, verify segments on workers, return index of first failing segment
+uint32_t rsha256_vnet_verify(
+const rsha256_vseg* segs,
+const uint32_t      num_segs,
+const char* const*  workers,
+const uint32_t      num_workers,
+const uint64_t      straggler_ms,
+const uint32_t      threads)
+{
+ //-- infusions not in protocol, those segments verified locally, rest sent to workers
+ std::vector<rsha256_vseg> nsegs;
+ std::vector<rsha256_vseg> lsegs;
+ std::vector<uint32_t> nidx;
+ std::vector<uint32_t> lidx;
+ for(uint32_t i = 0; i < num_segs; ++i){
+   if(segs[i].num_infusions > 0){ lsegs.push_back(segs[i]); lidx.push_back(i); }
+   else{ nsegs.push_back(segs[i]); nidx.push_back(i); }
+   }
+ if(nsegs.empty()) return rsha256_verify_segs(segs,num_segs,threads,NULL);
+
+ //-- local segments in parallel with workers
+ uint32_t lfail = (uint32_t)lsegs.size();
+ std::thread local;
+ if(!lsegs.empty()){
+   local = std::thread([&lsegs,&lfail,threads]{ lfail = rsha256_verify_segs(lsegs.data(),(uint32_t)lsegs.size(),threads,NULL); });
+   }
+
+ //-- tasks of batch segments, index in nsegs
+ const uint32_t num_nsegs = (uint32_t)nsegs.size();
+ std::vector<local_ctask> tasks;
+ for(uint32_t first = 0; first < num_nsegs; first += RSHA256PL_VNET_BATCH){
+   local_ctask task;
+   task.first = first;
+   task.count = (num_nsegs - first < RSHA256PL_VNET_BATCH) ? num_nsegs - first : RSHA256PL_VNET_BATCH;
+   task.active = 0;
+   task.sends = 0;
+   task.sent = 0;
+   task.done = false;
+   tasks.push_back(task);
+   }
+
+ //-- connect workers, window set by HELLO
+ std::vector<local_cpeer> peers(num_workers);
+ for(uint32_t w = 0; w < num_workers; ++w){
+   peers[w].fd = local_Connect(workers[w]);
+   peers[w].alive = (peers[w].fd >= 0);
+   peers[w].window = 0;
+   peers[w].inflight = 0;
+   }
+
+ uint32_t fail = num_nsegs;
+ uint32_t left = (uint32_t)tasks.size();
+ uint32_t nextpending = 0;
+ uint64_t avgns = 0;
+ std::vector<struct pollfd> pfds;
+ std::vector<uint32_t> pidx;
+
+ while(left > 0){
+
+   //-- fill windows, lowest pending task first, else straggler to idle worker
+   for(local_cpeer& peer : peers){
+     while(peer.alive && peer.window > 0 && peer.inflight < peer.window){
+       uint32_t pick = UINT32_MAX;
+       while(nextpending < tasks.size() && (tasks[nextpending].done || tasks[nextpending].active > 0)) ++nextpending;
+       for(uint32_t t = nextpending; t < tasks.size() && pick == UINT32_MAX; ++t){
+         if(tasks[t].first > fail) break;
+         if(!tasks[t].done && tasks[t].active == 0) pick = t;
+         }
+       if(pick == UINT32_MAX && peer.inflight == 0){
+         uint64_t now = local_NowNs();
+         uint64_t limit = (straggler_ms > 0) ? straggler_ms * 1000000 : 2 * avgns;
+         for(uint32_t t = 0; t < tasks.size(); ++t){
+           local_ctask* task = &tasks[t];
+           if(task->done || task->active == 0 || task->first > fail || task->sends >= 3) continue;
+           if(limit == 0 || now - task->sent < limit) continue;
+           if(pick == UINT32_MAX || task->sent < tasks[pick].sent) pick = t;
+           }
+         }
+       if(pick == UINT32_MAX) break;
+       if(!local_SendTask(&peer,nsegs.data(),pick,&tasks[pick])){ local_PeerLost(&peer,tasks,&nextpending); break; }
+       if(tasks[pick].active == 0) tasks[pick].sent = local_NowNs();
+       ++tasks[pick].active;
+       ++tasks[pick].sends;
+       peer.tasks.push_back(pick);
+       peer.inflight += tasks[pick].count;
+       }
+     }
+
+   //-- wait for frames from live workers, none left then rest locally
+   pfds.clear();
+   pidx.clear();
+   for(uint32_t w = 0; w < num_workers; ++w){
+     if(!peers[w].alive) continue;
+     struct pollfd pfd;
+     pfd.fd = peers[w].fd;
+     pfd.events = POLLIN;
+     pfd.revents = 0;
+     pfds.push_back(pfd);
+     pidx.push_back(w);
+     }
+   if(pfds.empty()) break;
+   if(poll(pfds.data(),(nfds_t)pfds.size(),50) < 0 && errno != EINTR) break;
+
+   for(size_t p = 0; p < pfds.size(); ++p){
+     if(pfds[p].revents == 0) continue;
+     local_cpeer* peer = &peers[pidx[p]];
+     uint8_t buf[4096];
+     ssize_t n = recv(peer->fd,buf,sizeof(buf),0);
+     if(n < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+     if(n <= 0){ local_PeerLost(peer,tasks,&nextpending); continue; }
+     peer->rbuf.insert(peer->rbuf.end(),buf,buf + n);
+
+     //-- complete frames in buffer
+     size_t pos = 0;
+     while(peer->alive && peer->rbuf.size() - pos >= 5){
+       uint32_t len = local_Get32(&peer->rbuf[pos]);
+       if(len < 1 || len > VNET_MAXLEN){ local_PeerLost(peer,tasks,&nextpending); break; }
+       if(peer->rbuf.size() - pos < 4 + (size_t)len) break;
+       uint8_t type = peer->rbuf[pos + 4];
+       const uint8_t* payload = &peer->rbuf[pos + 5];
+
+       if(type == VNET_HELLO && len == 5){
+         uint32_t wthreads = local_Get32(payload);
+         if(wthreads < 1) wthreads = 1;
+         peer->window = 2 * 2 * wthreads;
+         }
+       else if(type == VNET_RESULT && len == 13){
+         uint64_t t = local_Get64(payload);
+         uint32_t tfail = local_Get32(payload + 8);
+         for(size_t i = 0; i < peer->tasks.size(); ++i){
+           if(peer->tasks[i] != t) continue;
+           local_ctask* task = &tasks[t];
+           peer->tasks[i] = peer->tasks.back();
+           peer->tasks.pop_back();
+           peer->inflight -= task->count;
+           --task->active;
+           if(!task->done){
+             task->done = true;
+             --left;
+             uint64_t took = local_NowNs() - task->sent;
+             avgns = (avgns == 0) ? took : (avgns * 7 + took) / 8;
+             if(tfail < task->count && task->first + tfail < fail) fail = task->first + tfail;
+             }
+           break;
+           }
+         }
+       pos += 4 + (size_t)len;
+       }
+     if(peer->alive) peer->rbuf.erase(peer->rbuf.begin(),peer->rbuf.begin() + pos);
+     }
+
+   //-- tasks after first failing segment not needed
+   left = 0;
+   for(const local_ctask& task : tasks){ if(!task.done && task.first <= fail) ++left; }
+   }
+
+ for(local_cpeer& peer : peers){ if(peer.alive){ peer.alive = false; close(peer.fd); } }
+
+ //-- no workers left, rest locally
+ for(const local_ctask& task : tasks){
+   if(task.done || task.first > fail) continue;
+   uint32_t tfail = rsha256_verify_segs(&nsegs[task.first],task.count,threads,NULL);
+   if(tfail < task.count && task.first + tfail < fail) fail = task.first + tfail;
+   }
+
+ //-- merge, first failing segment of both sets in index of *segs
+ uint32_t result = (fail < num_nsegs) ? nidx[fail] : num_segs;
+ if(local.joinable()) local.join();
+ if(lfail < lsegs.size() && lidx[lfail] < result) result = lidx[lfail];
+ return result;
+}
+
+#else
+
+//-- no POSIX sockets, coordinator verifies locally
+int rsha256_vnet_listen(const char* addr,const uint16_t port){ (void)addr; (void)port; return -1; }
+uint16_t rsha256_vnet_port(const int listen_fd){ (void)listen_fd; return 0; }
+void rsha256_vnet_stop(const int listen_fd){ (void)listen_fd; }
+void rsha256_vnet_serve(const int listen_fd,const uint32_t threads,rsha256_vcache* cache){ (void)listen_fd; (void)threads; (void)cache; }
+uint32_t rsha256_vnet_verify(const rsha256_vseg* segs,const uint32_t num_segs,const char* const* workers,const uint32_t num_workers,const uint64_t straggler_ms,const uint32_t threads)
+{
+ (void)workers; (void)num_workers; (void)straggler_ms;
+ return rsha256_verify_segs(segs,num_segs,threads,NULL);
+}
+
+#endif
+
+// <eof>
@@ -0,0 +1,363 @@
+/*
+ * File: verifynet_mt.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Verify VDF segments on several hosts, with fast recursive SHA256
+ * Coordinator and workers over TCP (rsha256pl_vnet.cxx), or loopback in 1x process
+ *
+ * Program call: verifynet_mt -w <port> -p <workers> -l <num> -n <segs> -i <iters> -f <file> -s <hash> -x <seg> -t <threads>
+ *
+ * -w <port>: Worker, verify tasks from coordinators on port (optional)
+ *            Runs until stopped (Ctrl-C)
+ *
+ * -p <workers>: Coordinator, comma separated list of host:port (optional)
+ *
+ * -l <num>: Coordinator, with <num> loopback workers in same process (optional)
+ *           Default 2, if neither -w nor -p given
+ *
+ * -n <segs>: Number of test segments, independent, created locally (optional)
+ *            Default 64
+ *
+ * -i <iters>: Number of SHA256 iterations per segment/checkpoint (optional)
+ *             Default 10M, K/M/G suffix (1000)
+ *
+ * -f <file>: Verify checkpoints of file instead of test segments (optional)
+ *            32bytes binary hash/data every <iters>, from <hash>
+ *
+ * -s <hash>: 64 hex chars, hash/data at iteration 0 of -f <file> (optional)
+ *            Default 2EFD64A5... (same as benchmark_mt)
+ *
+ * -x <seg>: Flip 1st bit of end hash of segment <seg>, to test fail (optional)
+ *
+ * -t <threads>: Number of threads per worker, and to create test segments (optional)
+ *               Default 0 (by CPU budget), 256 (max)
+ *
+ * Requirement: Intel/AMD x64 CPU, with SHA Extensions, or
+ *              ARM CPU, with Cryptography Extensions
+ *              POSIX sockets (Linux, macOS)
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rsha256pl_verify.h"
+
+//-- local functions
+void local_ANSISetup(void);
+void local_ANSIRestore(void);
+void local_ParseParameters(int argc,char* argv[]);
+uint64_t local_ParseIters(const char* str);
+bool local_ParseHash(uint8_t* hash,const char* str);
+double local_Seconds(void);
+bool local_CreateSegments(std::vector<uint8_t>& hashes,std::vector<rsha256_vseg>& segs);
+int local_Worker(void);
+int local_Coordinator(void);
+
+//-- local parameter values
+uint32_t    local_mode;
+uint16_t    local_port;
+std::string local_workers;
+uint32_t    local_loopback;
+uint32_t    local_segs;
+uint64_t    local_iters;
+const char* local_file;
+uint8_t     local_start[32];
+uint32_t    local_fault;
+uint32_t    local_threads;
+
+//-- main() - entrypoint
+int main(int argc, char* argv[])
+{
+ int ret;
+
+ //-- setup/init ANSI capability
+ local_ANSISetup();
+
+ //-- default parameter values, -l 2, -n 64, -i 10M, -s 2EFD64A5..., -t 0
+ static const uint8_t hash_0[32] = { 0x2E,0xFD,0x64,0xA5,0x54,0x63,0xB5,0xB5,0x54,0xC4,0xA2,0xE2,0x2A,0x47,0x2D,0xA2,0x3B,0xB7,0x6E,0x63,0x75,0x8C,0xE3,0xC8,0x92,0x76,0xAB,0xF0,0xE9,0xAD,0x8B,0x15 };
+ local_mode = 0;
+ local_port = 0;
+ local_loopback = 2;
+ local_segs = 64;
+ local_iters = 10000000;
+ local_file = NULL;
+ memcpy(local_start,hash_0,32);
+ local_fault = UINT32_MAX;
+ local_threads = 0;
+
+ //-- display header
+ setvbuf(stdout,NULL,_IONBF,0);
+ printf("\33[1;97m[Verify net (mt) - Coordinator/workers over TCP]\33[0m\n");
+
+ //-- parse parameters
+ local_ParseParameters(argc,argv);
+
+ //-- mode: 0 = coordinator with loopback workers, 1 = coordinator, 2 = worker
+ if(local_mode == 2){ ret = local_Worker(); }
+ else               { ret = local_Coordinator(); }
+
+ //-- restore ANSI capability
+ local_ANSIRestore();
+
+ return ret;
+}
+
+//-- local_ParseParameters() - parse parameters
+void local_ParseParameters(int argc,char* argv[])
+{
+ for(int i = 1, jP = 0; i < argc; ++i){
+   if((char)jP == 'w'){
+     local_port = (uint16_t)atoi(argv[i]);
+     local_mode = 2;
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 'p'){
+     local_workers = argv[i];
+     local_mode = 1;
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 'l'){
+     local_loopback = atoi(argv[i]);
+     if(local_loopback < 1 || local_loopback > 64){ local_loopback = 2; }
+     local_mode = 0;
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 'n'){
+     local_segs = atoi(argv[i]);
+     if(local_segs < 1){ local_segs = 64; }
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 'i'){
+     local_iters = local_ParseIters(argv[i]);
+     if(local_iters < 1){ local_iters = 10000000; }
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 'f'){
+     local_file = argv[i];
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 's'){
+     if(!local_ParseHash(local_start,argv[i])){ printf("- \33[1;33mINFO: Invalid -s <hash>, 64 hex chars. Using default.\33[0m\n"); }
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 'x'){
+     local_fault = atoi(argv[i]);
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 't'){
+     local_threads = atoi(argv[i]);
+     if(local_threads > 256){ local_threads = 0; }
+     }
+
+   jP = 0;
+   if(!strcmp(argv[i],"-w")){ jP = 'w'; continue; }
+   if(!strcmp(argv[i],"-p")){ jP = 'p'; continue; }
+   if(!strcmp(argv[i],"-l")){ jP = 'l'; continue; }
+   if(!strcmp(argv[i],"-n")){ jP = 'n'; continue; }
+   if(!strcmp(argv[i],"-i")){ jP = 'i'; continue; }
+   if(!strcmp(argv[i],"-f")){ jP = 'f'; continue; }
+   if(!strcmp(argv[i],"-s")){ jP = 's'; continue; }
+   if(!strcmp(argv[i],"-x")){ jP = 'x'; continue; }
+   if(!strcmp(argv[i],"-t")){ jP = 't'; continue; }
+   }
+}
+
+//-- local_ParseIters() - number, with optional K/M/G suffix (1000)
+uint64_t local_ParseIters(const char* str)
+{
+ char* tail;
+ uint64_t val = strtoull(str,&tail,10);
+ if     (*tail == 'K' || *tail == 'k'){ val *= 1000; }
+ else if(*tail == 'M' || *tail == 'm'){ val *= 1000000; }
+ else if(*tail == 'G' || *tail == 'g'){ val *= 1000000000; }
+ return val;
+}
+
+//-- local_ParseHash() - 64 hex chars to 32bytes
+bool local_ParseHash(uint8_t* hash,const char* str)
+{
+ uint8_t tmp[32];
+ if(strlen(str) != 64) return false;
+ for(uint32_t i = 0; i < 32; ++i){
+   char byte[3] = { str[2 * i], str[2 * i + 1], 0 };
+   char* tail;
+   tmp[i] = (uint8_t)strtoul(byte,&tail,16);
+   if(*tail != 0) return false;
+   }
+ memcpy(hash,tmp,32);
+ return true;
+}
+
+//-- local_Seconds() - monotonic time in seconds
+double local_Seconds(void)
+{
+ return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//-- local_CreateSegments() - test segments (start, end) or checkpoints of file, 64bytes per segment
+bool local_CreateSegments(std::vector<uint8_t>& hashes,std::vector<rsha256_vseg>& segs)
+{
+ if(local_file != NULL){
+   FILE* file = fopen(local_file,"rb");
+   if(file == NULL){ fprintf(stderr,"\33[1;31mERROR: Cannot open file %s !\33[0m\n",local_file); return false; }
+   uint8_t hash[32];
+   hashes.assign(local_start,local_start + 32);
+   while(fread(hash,1,32,file) == 32){ hashes.insert(hashes.end(),hash,hash + 32); }
+   fclose(file);
+   local_segs = (uint32_t)(hashes.size() / 32) - 1;
+   if(local_segs < 1){ fprintf(stderr,"\33[1;31mERROR: No checkpoints in file %s !\33[0m\n",local_file); return false; }
+   segs.resize(local_segs);
+   for(uint32_t i = 0; i < local_segs; ++i){
+     segs[i].start = &hashes[32 * i];
+     segs[i].end = &hashes[32 * (i + 1)];
+     segs[i].iters = local_iters;
+     }
+   }
+ else{
+   //-- independent segments, start from hash_0 and index, end by _x2 on all threads
+   hashes.resize(64 * (size_t)local_segs);
+   for(uint32_t i = 0; i < local_segs; ++i){
+     memcpy(&hashes[64 * i],local_start,32);
+     for(uint32_t b = 0; b < 4; ++b){ hashes[64 * i + 28 + b] ^= (uint8_t)(i >> (8 * b)); }
+     memcpy(&hashes[64 * i + 32],&hashes[64 * i],32);
+     }
+   uint32_t nthreads = local_threads;
+   if(nthreads == 0){
+     rsha256_cpubudget budget;
+     rsha256_cpu_budget(&budget,1.0);
+     nthreads = budget.threads;
+     }
+   std::vector<std::thread> threads;
+   for(uint32_t t = 0; t < nthreads; ++t){
+     threads.emplace_back([&hashes,t,nthreads]{
+       alignas(64) uint8_t pair[64];
+       for(uint32_t i = 2 * t; i < local_segs; i += 2 * nthreads){
+         uint32_t lanes = (i + 1 < local_segs) ? 2 : 1;
+         for(uint32_t l = 0; l < lanes; ++l){ memcpy(&pair[32 * l],&hashes[64 * (i + l) + 32],32); }
+         if(lanes == 2) rsha256_fast_x2(pair,local_iters);
+         else           rsha256_fast_x1(pair,local_iters);
+         for(uint32_t l = 0; l < lanes; ++l){ memcpy(&hashes[64 * (i + l) + 32],&pair[32 * l],32); }
+         }
+       });
+     }
+   for(std::thread& thread : threads){ thread.join(); }
+   segs.resize(local_segs);
+   for(uint32_t i = 0; i < local_segs; ++i){
+     segs[i].start = &hashes[64 * i];
+     segs[i].end = &hashes[64 * i + 32];
+     segs[i].iters = local_iters;
+     }
+   }
+
+ //-- flip 1st bit of end hash, to test fail
+ if(local_fault < local_segs){ ((uint8_t*)segs[local_fault].end)[0] ^= 0x01; }
+ return true;
+}
+
+//-- local_Worker() - verify tasks from coordinators, until stopped
+int local_Worker(void)
+{
+ int fd = rsha256_vnet_listen(NULL,local_port);
+ if(fd < 0){ fprintf(stderr,"\33[1;31mERROR: Cannot listen on port %u !\33[0m\n",(unsigned)local_port); return 1; }
+ printf("- Worker: Listening on port %u, %d (threads, 0 = budget) ...\n",(unsigned)rsha256_vnet_port(fd),local_threads);
+ rsha256_vnet_serve(fd,local_threads,NULL);
+ return 0;
+}
+
+//-- local_Coordinator() - verify segments on workers, loopback workers started first if mode 0
+int local_Coordinator(void)
+{
+ std::vector<std::string> addrs;
+ std::vector<int> fds;
+ std::vector<std::thread> loopback;
+
+ if(local_mode == 0){
+   for(uint32_t w = 0; w < local_loopback; ++w){
+     int fd = rsha256_vnet_listen("127.0.0.1",0);
+     if(fd < 0){ fprintf(stderr,"\33[1;31mERROR: Cannot listen on loopback !\33[0m\n"); return 1; }
+     fds.push_back(fd);
+     addrs.push_back("127.0.0.1:" + std::to_string(rsha256_vnet_port(fd)));
+     loopback.emplace_back(rsha256_vnet_serve,fd,local_threads,(rsha256_vcache*)NULL);
+     }
+   }
+ else{
+   size_t pos = 0;
+   while(pos <= local_workers.size()){
+     size_t comma = local_workers.find(',',pos);
+     if(comma == std::string::npos) comma = local_workers.size();
+     if(comma > pos) addrs.push_back(local_workers.substr(pos,comma - pos));
+     pos = comma + 1;
+     }
+   }
+ std::vector<const char*> workers;
+ for(const std::string& addr : addrs){ workers.push_back(addr.c_str()); }
+
+ printf("- Parameters: %d (segments), %" PRIu64 " (iterations per segment), %d (workers), %d (threads, 0 = budget)\n",local_segs,local_iters,(int)workers.size(),local_threads);
+
+ printf("- Creating segments ...");
+ std::vector<uint8_t> hashes;
+ std::vector<rsha256_vseg> segs;
+ if(!local_CreateSegments(hashes,segs)){ return 1; }
+
+ printf("\33[2K\r- Verifying %d segments on %d workers ...",local_segs,(int)workers.size());
+ double timestart = local_Seconds();
+ uint32_t fail = rsha256_vnet_verify(segs.data(),local_segs,workers.data(),(uint32_t)workers.size(),0,local_threads);
+ double timediff = local_Seconds() - timestart;
+
+ for(int fd : fds){ rsha256_vnet_stop(fd); }
+ for(std::thread& thread : loopback){ thread.join(); }
+
+ double speedMHs = ((double)local_iters * (double)((fail < local_segs) ? fail + 1 : local_segs) / timediff) / 1000000.0;
+ if(fail == local_segs){ printf("\33[2K\r- Verified: \33[1;32mok\33[0m %.2f sec, \33[1;32m%.2f\33[0m MH/s (all workers)\n",timediff,speedMHs); }
+ else                  { printf("\33[2K\r- Verified: \33[1;31mfail\33[0m at segment %d, %.2f sec\n",fail,timediff); }
+
+ bool expected = (local_fault < local_segs) ? (fail == local_fault) : (fail == local_segs);
+ if(!expected){ fprintf(stderr,"\33[1;31mERROR: Result do not match expected !\33[0m\n"); return 1; }
+ return 0;
+}
+
+//-- local_ANSISetup() - setup/init ANSI capability (needed for Windows)
+//-- local_ANSIRestore() - restore ANSI capability (needed for Windows)
+#ifdef _WIN32
+#include <windows.h>
+static HANDLE local_win_stdout;
+static DWORD  local_win_savemode = 0;
+void local_ANSISetup(void)
+{
+ local_win_stdout = GetStdHandle(STD_OUTPUT_HANDLE);
+ if(local_win_stdout == INVALID_HANDLE_VALUE){ return; }
+ if(!GetConsoleMode(local_win_stdout,&local_win_savemode)){ local_win_savemode = 0; return; }
+ if(!SetConsoleMode(local_win_stdout,(local_win_savemode | ENABLE_VIRTUAL_TERMINAL_PROCESSING))){ local_win_savemode = 0; return; }
+}
+void local_ANSIRestore(void)
+{
+ if(!SetConsoleMode(local_win_stdout,local_win_savemode)){ return; }
+}
+#else
+void local_ANSISetup(void) {}
+void local_ANSIRestore(void) {}
+#endif
+
+// <eof>
@@ -0,0 +1,256 @@
+/*
+ * File: rsha256_fixed_arm.h
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Fast recursive SHA256 of fixed length message, with intrinsics and ARM Cryptography Extensions
+ * Template edition of rsha256_fast(), message length and output truncation at compile time
+ *
+ * rsha256_fixed<LEN,OUTLEN>() - SHA256 of LEN bytes, first OUTLEN bytes replaced by result
+ *
+ * Each iteration hashes LEN bytes of *data. First OUTLEN bytes are previous
+ * SHA256 value (truncated), rest of message is constant (salt, right half
+ * of pair). Padding and length words of each LEN are constant, only hash
+ * words change between iterations:
+ * - LEN 4-55: 1x block, constant message words kept in registers
+ * - LEN 56-119: 2x blocks, 2nd block constant, W+K of all 64x rounds
+ *   precomputed once, no message schedule in 2nd block
+ *
+ * rsha256_fixed<32,32>() is same loop as rsha256_fast()
+ *
+ * Requirement: ARM CPU, with Cryptography Extensions
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#ifndef RSHA256_FIXED_ARM_H
+#define RSHA256_FIXED_ARM_H
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+//-- array of 64x constants for SHA256 rounds
+static const uint32_t RSHA256FX_K64[64] = {
+  0x428A2F98,0x71374491,0xB5C0FBCF,0xE9B5DBA5,0x3956C25B,0x59F111F1,0x923F82A4,0xAB1C5ED5,
+  0xD807AA98,0x12835B01,0x243185BE,0x550C7DC3,0x72BE5D74,0x80DEB1FE,0x9BDC06A7,0xC19BF174,
+  0xE49B69C1,0xEFBE4786,0x0FC19DC6,0x240CA1CC,0x2DE92C6F,0x4A7484AA,0x5CB0A9DC,0x76F988DA,
+  0x983E5152,0xA831C66D,0xB00327C8,0xBF597FC7,0xC6E00BF3,0xD5A79147,0x06CA6351,0x14292967,
+  0x27B70A85,0x2E1B2138,0x4D2C6DFC,0x53380D13,0x650A7354,0x766A0ABB,0x81C2C92E,0x92722C85,
+  0xA2BFE8A1,0xA81A664B,0xC24B8B70,0xC76C51A3,0xD192E819,0xD6990624,0xF40E3585,0x106AA070,
+  0x19A4C116,0x1E376C08,0x2748774C,0x34B0BCB5,0x391C0CB3,0x4ED8AA4A,0x5B9CCA4F,0x682E6FF3,
+  0x748F82EE,0x78A5636F,0x84C87814,0x8CC70208,0x90BEFFFA,0xA4506CEB,0xBEF9A3F7,0xC67178F2
+  };
+
+//-- init values for SHA256 rounds, A-H logic
+static const uint32_t RSHA256FX_ABCDINIT[4] = {0x6A09E667,0xBB67AE85,0x3C6EF372,0xA54FF53A};
+static const uint32_t RSHA256FX_EFGHINIT[4] = {0x510E527F,0x9B05688C,0x1F83D9AB,0x5BE0CD19};
+
+//-- lane masks, n hash words first in 16bytes at &RSHA256FX_LANES[4 - n]
+static const uint32_t RSHA256FX_LANES[8] = {0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0x00000000,0x00000000,0x00000000,0x00000000};
+
+#define RSHA256FX_ROUND( \
+msgv, msgtmp0, msgtmp1, msgtmp2, msgtmp3, statev, state0, state1, kvalue) \
+  msgv = vaddq_u32(msgtmp0,vld1q_u32(kvalue)); \
+  statev = state0; \
+  state0 = vsha256hq_u32(state0,state1,msgv); \
+  state1 = vsha256h2q_u32(state1,statev,msgv); \
+  msgtmp3 = vsha256su1q_u32(msgtmp3,msgtmp1,msgtmp2); \
+  msgtmp0 = vsha256su0q_u32(msgtmp0,msgtmp1);
+
+#define RSHA256FX_ROUND_WK( \
+msgv, statev, state0, state1, wkvalue) \
+  msgv = vld1q_u32(wkvalue); \
+  statev = state0; \
+  state0 = vsha256hq_u32(state0,state1,msgv); \
+  state1 = vsha256h2q_u32(state1,statev,msgv);
+
+template<uint32_t LEN, uint32_t OUTLEN = 32>
+void rsha256_fixed(       //-- no return value, result to first OUTLEN bytes of *data
+uint8_t*       data,      //-- input/output LEN bytes, first OUTLEN bytes hash/data SHA256 value, rest constant
+const uint64_t num_iters) //-- number of times to SHA256 LEN bytes given in *data
+{
+ static_assert(OUTLEN >= 4 && OUTLEN <= 32 && OUTLEN % 4 == 0,"OUTLEN must be 4-32, multiple of 4");
+ static_assert(LEN >= OUTLEN && LEN <= 119,"LEN must be OUTLEN-119, max 2x blocks");
+
+ //-- number of blocks, hash words in 1st/2nd 16bytes of message
+ const bool     BLOCK2 = (LEN >= 56);
+ const uint32_t HWORDS = OUTLEN / 4;
+
+ //-- if 0 iterations, result is input hash/data
+ if(num_iters <= 0) return;
+
+ const uint32x4_t ABCD_INIT = vld1q_u32(&RSHA256FX_ABCDINIT[0]);
+ const uint32x4_t EFGH_INIT = vld1q_u32(&RSHA256FX_EFGHINIT[0]);
+ const uint32x4_t HASH_LANES = vld1q_u32(&RSHA256FX_LANES[4 - HWORDS % 4]);
+
+ //-- padded message, constant bytes, SHA256 padding logic (0x80, length in bits at end of last block)
+ alignas(16) uint8_t msg[128];
+ memset(msg,0,sizeof(msg));
+ memcpy(msg,data,LEN);
+ msg[LEN] = 0x80;
+ msg[(BLOCK2 ? 128 : 64) - 2] = (uint8_t)((LEN * 8) >> 8);
+ msg[(BLOCK2 ? 128 : 64) - 1] = (uint8_t)(LEN * 8);
+
+ //-- message words of 1st block, byte order of Cryptography Extensions, hash words replaced each iteration
+ const uint32x4_t MPAD0_CACHE = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&msg[0])));
+ const uint32x4_t MPAD1_CACHE = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&msg[16])));
+ const uint32x4_t MPAD2_CACHE = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&msg[32])));
+ const uint32x4_t MPAD3_CACHE = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&msg[48])));
+
+ //-- 2nd block constant, message schedule + K of 64x rounds precomputed
+ alignas(64) uint32_t WK2[64];
+ if(BLOCK2){
+   uint32_t w[64];
+   for(uint32_t i = 0; i < 16; ++i){
+     w[i] = ((uint32_t)msg[64 + 4 * i] << 24) | ((uint32_t)msg[65 + 4 * i] << 16) | ((uint32_t)msg[66 + 4 * i] << 8) | (uint32_t)msg[67 + 4 * i];
+     }
+   for(uint32_t i = 16; i < 64; ++i){
+     const uint32_t s0 = ((w[i - 15] >> 7) | (w[i - 15] << 25)) ^ ((w[i - 15] >> 18) | (w[i - 15] << 14)) ^ (w[i - 15] >> 3);
+     const uint32_t s1 = ((w[i - 2] >> 17) | (w[i - 2] << 15)) ^ ((w[i - 2] >> 19) | (w[i - 2] << 13)) ^ (w[i - 2] >> 10);
+     w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+     }
+   for(uint32_t i = 0; i < 64; ++i){ WK2[i] = w[i] + RSHA256FX_K64[i]; }
+   }
+
+ //-- variables to calculate SHA256 rounds
+ uint32x4_t STATE0;
+ uint32x4_t STATE1;
+ uint32x4_t STATEV;
+ uint32x4_t SAVE0;
+ uint32x4_t SAVE1;
+ uint32x4_t MSGV;
+ uint32x4_t MSG0;
+ uint32x4_t MSG1;
+ uint32x4_t MSGTMP0;
+ uint32x4_t MSGTMP1;
+ uint32x4_t MSGTMP2;
+ uint32x4_t MSGTMP3;
+
+ //-- variables to init/keep hash value through SHA256 rounds, 1st/2nd 16bytes of message
+ uint32x4_t HASH0_SAVE = MPAD0_CACHE;
+ uint32x4_t HASH1_SAVE = MPAD1_CACHE;
+
+ //-- repeat SHA256 operation number of iterations
+ for(uint64_t i = 0; i < num_iters; ++i){
+
+   //-- init state value for SHA256 rounds
+   STATE0 = ABCD_INIT;
+   STATE1 = EFGH_INIT;
+
+   //-- hash words (truncated) and constant words
+   MSG0 = (HWORDS >= 4) ? HASH0_SAVE : vbslq_u32(HASH_LANES,HASH0_SAVE,MPAD0_CACHE);
+   MSG1 = (HWORDS >= 8) ? HASH1_SAVE : (HWORDS <= 4) ? MPAD1_CACHE : vbslq_u32(HASH_LANES,HASH1_SAVE,MPAD1_CACHE);
+
+   //-- rounds 0-3
+   MSGV = vaddq_u32(MSG0,vld1q_u32(&RSHA256FX_K64[0]));
+   STATEV = STATE0;
+   STATE0 = vsha256hq_u32(STATE0,STATE1,MSGV);
+   STATE1 = vsha256h2q_u32(STATE1,STATEV,MSGV);
+   MSGTMP0 = vsha256su0q_u32(MSG0,MSG1);
+
+   //-- rounds 4-7
+   MSGV = vaddq_u32(MSG1,vld1q_u32(&RSHA256FX_K64[4]));
+   STATEV = STATE0;
+   STATE0 = vsha256hq_u32(STATE0,STATE1,MSGV);
+   STATE1 = vsha256h2q_u32(STATE1,STATEV,MSGV);
+   MSGTMP0 = vsha256su1q_u32(MSGTMP0,MPAD2_CACHE,MPAD3_CACHE);
+   MSGTMP1 = vsha256su0q_u32(MSG1,MPAD2_CACHE);
+
+   //-- rounds 8-11
+   MSGV = vaddq_u32(MPAD2_CACHE,vld1q_u32(&RSHA256FX_K64[8]));
+   STATEV = STATE0;
+   STATE0 = vsha256hq_u32(STATE0,STATE1,MSGV);
+   STATE1 = vsha256h2q_u32(STATE1,STATEV,MSGV);
+   MSGTMP1 = vsha256su1q_u32(MSGTMP1,MPAD3_CACHE,MSGTMP0);
+   MSGTMP2 = vsha256su0q_u32(MPAD2_CACHE,MPAD3_CACHE);
+
+   //-- rounds 12-15
+   MSGV = vaddq_u32(MPAD3_CACHE,vld1q_u32(&RSHA256FX_K64[12]));
+   STATEV = STATE0;
+   STATE0 = vsha256hq_u32(STATE0,STATE1,MSGV);
+   STATE1 = vsha256h2q_u32(STATE1,STATEV,MSGV);
+   MSGTMP2 = vsha256su1q_u32(MSGTMP2,MSGTMP0,MSGTMP1);
+   MSGTMP3 = vsha256su0q_u32(MPAD3_CACHE,MSGTMP0);
+
+   //-- rounds 16-19, 20-23, 24-27, 28-31
+   RSHA256FX_ROUND(MSGV,MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,STATEV,STATE0,STATE1,&RSHA256FX_K64[16]);
+   RSHA256FX_ROUND(MSGV,MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0,STATEV,STATE0,STATE1,&RSHA256FX_K64[20]);
+   RSHA256FX_ROUND(MSGV,MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1,STATEV,STATE0,STATE1,&RSHA256FX_K64[24]);
+   RSHA256FX_ROUND(MSGV,MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,STATEV,STATE0,STATE1,&RSHA256FX_K64[28]);
+
+   //-- rounds 32-35, 36-39, 40-43, 44-47
+   RSHA256FX_ROUND(MSGV,MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,STATEV,STATE0,STATE1,&RSHA256FX_K64[32]);
+   RSHA256FX_ROUND(MSGV,MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0,STATEV,STATE0,STATE1,&RSHA256FX_K64[36]);
+   RSHA256FX_ROUND(MSGV,MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1,STATEV,STATE0,STATE1,&RSHA256FX_K64[40]);
+   RSHA256FX_ROUND(MSGV,MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,STATEV,STATE0,STATE1,&RSHA256FX_K64[44]);
+
+   //-- rounds 48-51
+   MSGV = vaddq_u32(MSGTMP0,vld1q_u32(&RSHA256FX_K64[48]));
+   STATEV = STATE0;
+   STATE0 = vsha256hq_u32(STATE0,STATE1,MSGV);
+   STATE1 = vsha256h2q_u32(STATE1,STATEV,MSGV);
+   MSGTMP3 = vsha256su1q_u32(MSGTMP3,MSGTMP1,MSGTMP2);
+
+   //-- rounds 52-55
+   MSGV = vaddq_u32(MSGTMP1,vld1q_u32(&RSHA256FX_K64[52]));
+   STATEV = STATE0;
+   STATE0 = vsha256hq_u32(STATE0,STATE1,MSGV);
+   STATE1 = vsha256h2q_u32(STATE1,STATEV,MSGV);
+
+   //-- rounds 56-59
+   MSGV = vaddq_u32(MSGTMP2,vld1q_u32(&RSHA256FX_K64[56]));
+   STATEV = STATE0;
+   STATE0 = vsha256hq_u32(STATE0,STATE1,MSGV);
+   STATE1 = vsha256h2q_u32(STATE1,STATEV,MSGV);
+
+   //-- rounds 60-63
+   MSGV = vaddq_u32(MSGTMP3,vld1q_u32(&RSHA256FX_K64[60]));
+   STATEV = STATE0;
+   STATE0 = vsha256hq_u32(STATE0,STATE1,MSGV);
+   STATE1 = vsha256h2q_u32(STATE1,STATEV,MSGV);
+
+   //-- add init state to current state
+   HASH0_SAVE = vaddq_u32(STATE0,ABCD_INIT);
+   HASH1_SAVE = vaddq_u32(STATE1,EFGH_INIT);
+
+   //-- 2nd block, rounds on precomputed W+K only, add 1st block state
+   if(BLOCK2){
+     STATE0 = HASH0_SAVE;
+     STATE1 = HASH1_SAVE;
+     SAVE0 = HASH0_SAVE;
+     SAVE1 = HASH1_SAVE;
+     for(uint32_t r = 0; r < 64; r += 4){ RSHA256FX_ROUND_WK(MSGV,STATEV,STATE0,STATE1,&WK2[r]); }
+     HASH0_SAVE = vaddq_u32(STATE0,SAVE0);
+     HASH1_SAVE = vaddq_u32(STATE1,SAVE1);
+     }
+   }
+
+ //-- shuffle Cryptography Extensions hash value back
+ HASH0_SAVE = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(HASH0_SAVE)));
+ HASH1_SAVE = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(HASH1_SAVE)));
+
+ //-- copy/return final hash value (truncated) into *data, rest of message untouched
+ alignas(16) uint8_t out[32];
+ vst1q_u32((uint32_t*)(&out[0]),HASH0_SAVE);
+ vst1q_u32((uint32_t*)(&out[16]),HASH1_SAVE);
+ memcpy(data,out,OUTLEN);
+}
+
+#undef RSHA256FX_ROUND
+#undef RSHA256FX_ROUND_WK
+
+#endif
+
+#endif
+
+// <eof>
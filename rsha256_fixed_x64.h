@@ -0,0 +1,265 @@
+/*
+ * File: rsha256_fixed_x64.h
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Fast recursive SHA256 of fixed length message, with intrinsics and Intel SHA Extensions
+ * Template edition of rsha256_fast(), message length and output truncation at compile time
+ *
+ * rsha256_fixed<LEN,OUTLEN>() - SHA256 of LEN bytes, first OUTLEN bytes replaced by result
+ *
+ * Each iteration hashes LEN bytes of *data. First OUTLEN bytes are previous
+ * SHA256 value (truncated), rest of message is constant (salt, right half
+ * of pair). Padding and length words of each LEN are constant, only hash
+ * words change between iterations:
+ * - LEN 4-55: 1x block, constant message words kept in registers
+ * - LEN 56-119: 2x blocks, 2nd block constant, W+K of all 64x rounds
+ *   precomputed once, no message schedule in 2nd block
+ *
+ * rsha256_fixed<32,32>() is same loop as rsha256_fast()
+ *
+ * Requirement: Intel/AMD x64 CPU, with SHA Extensions
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#ifndef RSHA256_FIXED_X64_H
+#define RSHA256_FIXED_X64_H
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__amd64__) || defined(_M_AMD64)
+#include <immintrin.h>
+#endif
+
+#ifdef _WIN32
+#include <intrin.h>
+#endif
+
+#if defined(__amd64__) || defined(_M_AMD64)
+
+//-- array of 64x constants for SHA256 rounds
+alignas(64) static const uint32_t RSHA256FX_K64[64] = {
+  0x428A2F98,0x71374491,0xB5C0FBCF,0xE9B5DBA5,0x3956C25B,0x59F111F1,0x923F82A4,0xAB1C5ED5,
+  0xD807AA98,0x12835B01,0x243185BE,0x550C7DC3,0x72BE5D74,0x80DEB1FE,0x9BDC06A7,0xC19BF174,
+  0xE49B69C1,0xEFBE4786,0x0FC19DC6,0x240CA1CC,0x2DE92C6F,0x4A7484AA,0x5CB0A9DC,0x76F988DA,
+  0x983E5152,0xA831C66D,0xB00327C8,0xBF597FC7,0xC6E00BF3,0xD5A79147,0x06CA6351,0x14292967,
+  0x27B70A85,0x2E1B2138,0x4D2C6DFC,0x53380D13,0x650A7354,0x766A0ABB,0x81C2C92E,0x92722C85,
+  0xA2BFE8A1,0xA81A664B,0xC24B8B70,0xC76C51A3,0xD192E819,0xD6990624,0xF40E3585,0x106AA070,
+  0x19A4C116,0x1E376C08,0x2748774C,0x34B0BCB5,0x391C0CB3,0x4ED8AA4A,0x5B9CCA4F,0x682E6FF3,
+  0x748F82EE,0x78A5636F,0x84C87814,0x8CC70208,0x90BEFFFA,0xA4506CEB,0xBEF9A3F7,0xC67178F2
+  };
+
+#define RSHA256FX_ROUND( \
+msgv, msgtmp0, msgtmp1, msgtmp2, msgtmp3, state0, state1, kvalue) \
+  msgv = msgtmp0; \
+  msgv = _mm_add_epi32(msgv,_mm_load_si128((__m128i*)(kvalue))); \
+  state1 = _mm_sha256rnds2_epu32(state1,state0,msgv); \
+  msgtmp1 = _mm_add_epi32(msgtmp1,_mm_alignr_epi8(msgtmp0,msgtmp3,4)); \
+  msgtmp1 = _mm_sha256msg2_epu32(msgtmp1,msgtmp0); \
+  msgv = _mm_shuffle_epi32(msgv,0x0E); \
+  state0 = _mm_sha256rnds2_epu32(state0,state1,msgv); \
+  msgtmp3 = _mm_sha256msg1_epu32(msgtmp3,msgtmp0);
+
+#define RSHA256FX_ROUND_WK( \
+msgv, state0, state1, wkvalue) \
+  msgv = _mm_load_si128((__m128i*)(wkvalue)); \
+  state1 = _mm_sha256rnds2_epu32(state1,state0,msgv); \
+  msgv = _mm_shuffle_epi32(msgv,0x0E); \
+  state0 = _mm_sha256rnds2_epu32(state0,state1,msgv);
+
+template<uint32_t LEN, uint32_t OUTLEN = 32>
+void rsha256_fixed(       //-- no return value, result to first OUTLEN bytes of *data
+uint8_t*       data,      //-- input/output LEN bytes, first OUTLEN bytes hash/data SHA256 value, rest constant
+const uint64_t num_iters) //-- number of times to SHA256 LEN bytes given in *data
+{
+ static_assert(OUTLEN >= 4 && OUTLEN <= 32 && OUTLEN % 4 == 0,"OUTLEN must be 4-32, multiple of 4");
+ static_assert(LEN >= OUTLEN && LEN <= 119,"LEN must be OUTLEN-119, max 2x blocks");
+
+ //-- number of blocks, hash words in 1st/2nd 16bytes of message, lanes 16bit of constant words
+ const bool     BLOCK2 = (LEN >= 56);
+ const uint32_t HWORDS = OUTLEN / 4;
+ const int      BLEND = (0xFF << (2 * (HWORDS % 4))) & 0xFF;
+
+ //-- if 0 iterations, result is input hash/data
+ if(num_iters <= 0) return;
+
+ //-- shuffle mask for byte order required by SHA Extensions
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+
+ //-- pre-arranged/shuffled state values for SHA256 rounds, A-H logic
+ const __m128i ABEF_INIT = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ const __m128i CDGH_INIT = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+
+ //-- padded message, constant bytes, SHA256 padding logic (0x80, length in bits at end of last block)
+ alignas(16) uint8_t msg[128];
+ memset(msg,0,sizeof(msg));
+ memcpy(msg,data,LEN);
+ msg[LEN] = 0x80;
+ msg[(BLOCK2 ? 128 : 64) - 2] = (uint8_t)((LEN * 8) >> 8);
+ msg[(BLOCK2 ? 128 : 64) - 1] = (uint8_t)(LEN * 8);
+
+ //-- shuffled message words of 1st block, hash words replaced each iteration
+ const __m128i MPAD0_CACHE = _mm_shuffle_epi8(_mm_load_si128((__m128i*)(&msg[0])),SHUF_MASK);
+ const __m128i MPAD1_CACHE = _mm_shuffle_epi8(_mm_load_si128((__m128i*)(&msg[16])),SHUF_MASK);
+ const __m128i MPAD2_CACHE = _mm_shuffle_epi8(_mm_load_si128((__m128i*)(&msg[32])),SHUF_MASK);
+ const __m128i MPAD3_CACHE = _mm_shuffle_epi8(_mm_load_si128((__m128i*)(&msg[48])),SHUF_MASK);
+
+ //-- 2nd block constant, message schedule + K of 64x rounds precomputed
+ alignas(64) uint32_t WK2[64];
+ if(BLOCK2){
+   uint32_t w[64];
+   for(uint32_t i = 0; i < 16; ++i){
+     w[i] = ((uint32_t)msg[64 + 4 * i] << 24) | ((uint32_t)msg[65 + 4 * i] << 16) | ((uint32_t)msg[66 + 4 * i] << 8) | (uint32_t)msg[67 + 4 * i];
+     }
+   for(uint32_t i = 16; i < 64; ++i){
+     const uint32_t s0 = ((w[i - 15] >> 7) | (w[i - 15] << 25)) ^ ((w[i - 15] >> 18) | (w[i - 15] << 14)) ^ (w[i - 15] >> 3);
+     const uint32_t s1 = ((w[i - 2] >> 17) | (w[i - 2] << 15)) ^ ((w[i - 2] >> 19) | (w[i - 2] << 13)) ^ (w[i - 2] >> 10);
+     w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+     }
+   for(uint32_t i = 0; i < 64; ++i){ WK2[i] = w[i] + RSHA256FX_K64[i]; }
+   }
+
+ //-- variables to calculate SHA256 rounds
+ __m128i STATE0;
+ __m128i STATE1;
+ __m128i SAVE0;
+ __m128i SAVE1;
+ __m128i MSGV;
+ __m128i MSGTMP0;
+ __m128i MSGTMP1;
+ __m128i MSGTMP2;
+ __m128i MSGTMP3;
+
+ //-- variables to init/keep hash value through SHA256 rounds, 1st/2nd 16bytes of message
+ __m128i HASH0_SAVE = MPAD0_CACHE;
+ __m128i HASH1_SAVE = MPAD1_CACHE;
+
+ //-- repeat SHA256 operation number of iterations
+ for(uint64_t i = 0; i < num_iters; ++i){
+
+   //-- init state value for SHA256 rounds
+   STATE0 = ABEF_INIT;
+   STATE1 = CDGH_INIT;
+
+   //-- rounds 0-3, hash words (truncated) and constant words
+   MSGV = (HWORDS >= 4) ? HASH0_SAVE : _mm_blend_epi16(HASH0_SAVE,MPAD0_CACHE,BLEND);
+   MSGTMP0 = MSGV;
+   MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&RSHA256FX_K64[0])));
+   STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+   MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+   STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+
+   //-- rounds 4-7
+   MSGV = (HWORDS >= 8) ? HASH1_SAVE : (HWORDS <= 4) ? MPAD1_CACHE : _mm_blend_epi16(HASH1_SAVE,MPAD1_CACHE,BLEND);
+   MSGTMP1 = MSGV;
+   MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&RSHA256FX_K64[4])));
+   STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+   MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+   STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+   MSGTMP0 = _mm_sha256msg1_epu32(MSGTMP0,MSGTMP1);
+
+   //-- rounds 8-11
+   MSGV = MPAD2_CACHE;
+   MSGTMP2 = MSGV;
+   MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&RSHA256FX_K64[8])));
+   STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+   MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+   STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+   MSGTMP1 = _mm_sha256msg1_epu32(MSGTMP1,MSGTMP2);
+
+   //-- rounds 12-15
+   MSGV = MPAD3_CACHE;
+   MSGTMP3 = MSGV;
+   MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&RSHA256FX_K64[12])));
+   STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+   MSGTMP0 = _mm_add_epi32(MSGTMP0,_mm_alignr_epi8(MSGTMP3,MSGTMP2,4));
+   MSGTMP0 = _mm_sha256msg2_epu32(MSGTMP0,MSGTMP3);
+   MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+   STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+   MSGTMP2 = _mm_sha256msg1_epu32(MSGTMP2,MSGTMP3);
+
+   //-- rounds 16-19, 20-23, 24-27, 28-31
+   RSHA256FX_ROUND(MSGV,MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,STATE0,STATE1,&RSHA256FX_K64[16]);
+   RSHA256FX_ROUND(MSGV,MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0,STATE0,STATE1,&RSHA256FX_K64[20]);
+   RSHA256FX_ROUND(MSGV,MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1,STATE0,STATE1,&RSHA256FX_K64[24]);
+   RSHA256FX_ROUND(MSGV,MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,STATE0,STATE1,&RSHA256FX_K64[28]);
+
+   //-- rounds 32-35, 36-39, 40-43, 44-47
+   RSHA256FX_ROUND(MSGV,MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,STATE0,STATE1,&RSHA256FX_K64[32]);
+   RSHA256FX_ROUND(MSGV,MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0,STATE0,STATE1,&RSHA256FX_K64[36]);
+   RSHA256FX_ROUND(MSGV,MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1,STATE0,STATE1,&RSHA256FX_K64[40]);
+   RSHA256FX_ROUND(MSGV,MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,STATE0,STATE1,&RSHA256FX_K64[44]);
+
+   //-- rounds 48-51
+   RSHA256FX_ROUND(MSGV,MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,STATE0,STATE1,&RSHA256FX_K64[48]);
+
+   //-- rounds 52-55
+   MSGV = MSGTMP1;
+   MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&RSHA256FX_K64[52])));
+   STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+   MSGTMP2 = _mm_add_epi32(MSGTMP2,_mm_alignr_epi8(MSGTMP1,MSGTMP0,4));
+   MSGTMP2 = _mm_sha256msg2_epu32(MSGTMP2,MSGTMP1);
+   MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+   STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+
+   //-- rounds 56-59
+   MSGV = MSGTMP2;
+   MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&RSHA256FX_K64[56])));
+   STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+   MSGTMP3 = _mm_add_epi32(MSGTMP3,_mm_alignr_epi8(MSGTMP2,MSGTMP1,4));
+   MSGTMP3 = _mm_sha256msg2_epu32(MSGTMP3,MSGTMP2);
+   MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+   STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+
+   //-- rounds 60-63
+   MSGV = MSGTMP3;
+   MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&RSHA256FX_K64[60])));
+   STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+   MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+   STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+
+   //-- add init state to current state
+   STATE0 = _mm_add_epi32(STATE0,ABEF_INIT);
+   STATE1 = _mm_add_epi32(STATE1,CDGH_INIT);
+
+   //-- 2nd block, rounds on precomputed W+K only, add 1st block state
+   if(BLOCK2){
+     SAVE0 = STATE0;
+     SAVE1 = STATE1;
+     for(uint32_t r = 0; r < 64; r += 4){ RSHA256FX_ROUND_WK(MSGV,STATE0,STATE1,&WK2[r]); }
+     STATE0 = _mm_add_epi32(STATE0,SAVE0);
+     STATE1 = _mm_add_epi32(STATE1,SAVE1);
+     }
+
+   //-- shuffle state, save for next iteration or final result
+   STATE0 = _mm_shuffle_epi32(STATE0,0x1B); // FEBA
+   STATE1 = _mm_shuffle_epi32(STATE1,0xB1); // DCHG
+   HASH0_SAVE = _mm_blend_epi16(STATE0,STATE1,0xF0); // DCBA
+   HASH1_SAVE = _mm_alignr_epi8(STATE1,STATE0,8);    // HGFE
+   }
+
+ //-- shuffle SHA Extensions hash value back
+ HASH0_SAVE = _mm_shuffle_epi8(HASH0_SAVE,SHUF_MASK);
+ HASH1_SAVE = _mm_shuffle_epi8(HASH1_SAVE,SHUF_MASK);
+
+ //-- copy/return final hash value (truncated) into *data, rest of message untouched
+ alignas(16) uint8_t out[32];
+ _mm_store_si128((__m128i*)(&out[0]),HASH0_SAVE);
+ _mm_store_si128((__m128i*)(&out[16]),HASH1_SAVE);
+ memcpy(data,out,OUTLEN);
+}
+
+#undef RSHA256FX_ROUND
+#undef RSHA256FX_ROUND_WK
+
+#endif
+
+#endif
+
+// <eof>
@@ -0,0 +1,294 @@
+/*
+ * File: rsha256_tuned_arm.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Fast recursive SHA256 variants, with intrinsics and ARM Cryptography Extensions
+ * Variant calibrated per core type (MIDR implementer/part number)
+ *
+ * rsha256_tuned() - Same as rsha256_fast(), variant of calling thread's core
+ * rsha256_tuned_select() - (Re)select variant for calling thread's core
+ * rsha256_tuned_calibrate() - Time all variants on calling thread's core
+ *
+ * Variants differ in instruction order (su0/su1 after hash rounds, or
+ * message schedule ahead of rounds) and unroll (1x or 2x iterations per
+ * loop trip). Same result, different scheduling in core. No encoding
+ * variants on ARM, 1x instruction set.
+ *
+ * Table of calibrated CPU keys picks variant. 1st select on a core type not
+ * in table (1st rsha256_tuned() of a thread) times all variants, fastest
+ * kept for its key, once per key and process. Default variant is base
+ * (same as rsha256_fast()) if table is full. MIDR read on Linux (mrs,
+ * emulated by kernel), else unknown core (0). big.LITTLE CPU, pin thread
+ * (rsha256_isolate()) before select/calibrate.
+ *
+ * Requirement: ARM CPU, with Cryptography Extensions
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <stdint.h>
+
+#include <chrono>
+#include <mutex>
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#if defined(__GNUC__)
+#define TUNED_INLINE inline __attribute__((always_inline))
+#else
+#define TUNED_INLINE __forceinline
+#endif
+
+//-- max number of CPU keys calibrated in 1x process
+#ifndef RSHA256_TUNED_CALIBRATED
+#define RSHA256_TUNED_CALIBRATED 16
+#endif
+
+//-- iterations per variant and run of calibration (best of 3x)
+#ifndef RSHA256_TUNED_ITERS
+#define RSHA256_TUNED_ITERS 250000
+#endif
+
+//-- array of 64x constants for SHA256 rounds
+static const uint32_t K64[64] = {
+  0x428A2F98,0x71374491,0xB5C0FBCF,0xE9B5DBA5,0x3956C25B,0x59F111F1,0x923F82A4,0xAB1C5ED5,
+  0xD807AA98,0x12835B01,0x243185BE,0x550C7DC3,0x72BE5D74,0x80DEB1FE,0x9BDC06A7,0xC19BF174,
+  0xE49B69C1,0xEFBE4786,0x0FC19DC6,0x240CA1CC,0x2DE92C6F,0x4A7484AA,0x5CB0A9DC,0x76F988DA,
+  0x983E5152,0xA831C66D,0xB00327C8,0xBF597FC7,0xC6E00BF3,0xD5A79147,0x06CA6351,0x14292967,
+  0x27B70A85,0x2E1B2138,0x4D2C6DFC,0x53380D13,0x650A7354,0x766A0ABB,0x81C2C92E,0x92722C85,
+  0xA2BFE8A1,0xA81A664B,0xC24B8B70,0xC76C51A3,0xD192E819,0xD6990624,0xF40E3585,0x106AA070,
+  0x19A4C116,0x1E376C08,0x2748774C,0x34B0BCB5,0x391C0CB3,0x4ED8AA4A,0x5B9CCA4F,0x682E6FF3,
+  0x748F82EE,0x78A5636F,0x84C87814,0x8CC70208,0x90BEFFFA,0xA4506CEB,0xBEF9A3F7,0xC67178F2
+  };
+
+//-- init values for SHA256 rounds, A-H logic
+static const uint32_t abcdinit[4] = {0x6A09E667,0xBB67AE85,0x3C6EF372,0xA54FF53A};
+static const uint32_t efghinit[4] = {0x510E527F,0x9B05688C,0x1F83D9AB,0x5BE0CD19};
+
+//-- pre-arranged values for 3rd/4th 16bytes of 1x block, SHA256 padding logic
+static const uint32_t hpad0cache[4] = {0x80000000,0x00000000,0x00000000,0x00000000};
+static const uint32_t hpad1cache[4] = {0x00000000,0x00000000,0x00000000,0x00000100};
+
+//-- 4x rounds, message msgtmp0, su1 into msgtmp3 and su0 into msgtmp0 if set
+//-- MSGFIRST: message schedule ahead of hash rounds, else after (rsha256_fast())
+#define TUNED_ROUND(msgtmp0, msgtmp1, msgtmp2, msgtmp3, kindex, dosu1, dosu0) \
+  MSGV = vaddq_u32(msgtmp0,vld1q_u32(&K64[kindex])); \
+  if(MSGFIRST){ \
+    if(dosu1){ msgtmp3 = vsha256su1q_u32(msgtmp3,msgtmp1,msgtmp2); } \
+    if(dosu0){ msgtmp0 = vsha256su0q_u32(msgtmp0,msgtmp1); } \
+    } \
+  STATEV = STATE0; \
+  STATE0 = vsha256hq_u32(STATE0,STATE1,MSGV); \
+  STATE1 = vsha256h2q_u32(STATE1,STATEV,MSGV); \
+  if(!MSGFIRST){ \
+    if(dosu1){ msgtmp3 = vsha256su1q_u32(msgtmp3,msgtmp1,msgtmp2); } \
+    if(dosu0){ msgtmp0 = vsha256su0q_u32(msgtmp0,msgtmp1); } \
+    }
+
+//-- local_Iter() - 1x iteration, SHA256 of 32bytes in HASH0_SAVE/HASH1_SAVE
+template<bool MSGFIRST>
+static TUNED_INLINE void local_Iter(
+uint32x4_t&      HASH0_SAVE,
+uint32x4_t&      HASH1_SAVE,
+const uint32x4_t ABCD_INIT,
+const uint32x4_t EFGH_INIT,
+const uint32x4_t HPAD0_CACHE,
+const uint32x4_t HPAD1_CACHE)
+{
+ //-- init state value for SHA256 rounds
+ uint32x4_t STATE0 = ABCD_INIT;
+ uint32x4_t STATE1 = EFGH_INIT;
+ uint32x4_t STATEV;
+ uint32x4_t MSGV;
+
+ //-- 1x block, hash + SHA256 padding logic (su0 of padding words is 0, skipped)
+ uint32x4_t MSGTMP0 = HASH0_SAVE;
+ uint32x4_t MSGTMP1 = HASH1_SAVE;
+ uint32x4_t MSGTMP2 = HPAD0_CACHE;
+ uint32x4_t MSGTMP3 = HPAD1_CACHE;
+
+ //-- rounds 0-3, 4-7, 8-11, 12-15
+ TUNED_ROUND(MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3, 0,0,1);
+ TUNED_ROUND(MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0, 4,1,1);
+ TUNED_ROUND(MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1, 8,1,0);
+ TUNED_ROUND(MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,12,1,1);
+
+ //-- rounds 16-19, 20-23, 24-27, 28-31
+ TUNED_ROUND(MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,16,1,1);
+ TUNED_ROUND(MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0,20,1,1);
+ TUNED_ROUND(MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1,24,1,1);
+ TUNED_ROUND(MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,28,1,1);
+
+ //-- rounds 32-35, 36-39, 40-43, 44-47
+ TUNED_ROUND(MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,32,1,1);
+ TUNED_ROUND(MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0,36,1,1);
+ TUNED_ROUND(MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1,40,1,1);
+ TUNED_ROUND(MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,44,1,1);
+
+ //-- rounds 48-51, 52-55, 56-59, 60-63
+ TUNED_ROUND(MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,48,1,0);
+ TUNED_ROUND(MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0,52,0,0);
+ TUNED_ROUND(MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1,56,0,0);
+ TUNED_ROUND(MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,60,0,0);
+
+ //-- add init state to current state
+ HASH0_SAVE = vaddq_u32(STATE0,ABCD_INIT);
+ HASH1_SAVE = vaddq_u32(STATE1,EFGH_INIT);
+}
+
+//-- local_Fast() - loop of rsha256_fast(), instruction order and unroll at compile time
+template<bool MSGFIRST, uint32_t UNROLL>
+static void local_Fast(
+uint8_t*       hash,
+const uint64_t num_iters)
+{
+ //-- if 0 iterations, result is input hash/data
+ if(num_iters <= 0) return;
+
+ const uint32x4_t ABCD_INIT = vld1q_u32(&abcdinit[0]);
+ const uint32x4_t EFGH_INIT = vld1q_u32(&efghinit[0]);
+ const uint32x4_t HPAD0_CACHE = vld1q_u32(&hpad0cache[0]);
+ const uint32x4_t HPAD1_CACHE = vld1q_u32(&hpad1cache[0]);
+
+ //-- variables to init/keep hash value through SHA256 rounds, shuffled for Cryptography Extensions
+ uint32x4_t HASH0_SAVE = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&hash[0])));
+ uint32x4_t HASH1_SAVE = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&hash[16])));
+
+ //-- UNROLL iterations per loop trip, rest 1x at a time
+ uint64_t i = 0;
+ for(; i + UNROLL <= num_iters; i += UNROLL){
+   local_Iter<MSGFIRST>(HASH0_SAVE,HASH1_SAVE,ABCD_INIT,EFGH_INIT,HPAD0_CACHE,HPAD1_CACHE);
+   if(UNROLL > 1){ local_Iter<MSGFIRST>(HASH0_SAVE,HASH1_SAVE,ABCD_INIT,EFGH_INIT,HPAD0_CACHE,HPAD1_CACHE); }
+   }
+ for(; i < num_iters; ++i){ local_Iter<MSGFIRST>(HASH0_SAVE,HASH1_SAVE,ABCD_INIT,EFGH_INIT,HPAD0_CACHE,HPAD1_CACHE); }
+
+ //-- shuffle Cryptography Extensions hash value back, copy/return final hash value into *hash
+ vst1q_u8(&hash[0],vrev32q_u8(vreinterpretq_u8_u32(HASH0_SAVE)));
+ vst1q_u8(&hash[16],vrev32q_u8(vreinterpretq_u8_u32(HASH1_SAVE)));
+}
+
+typedef void (*local_fastfunc)(uint8_t*,const uint64_t);
+
+struct local_tunedvariant {
+ const char*    name;
+ local_fastfunc func;
+};
+
+//-- index 0 is default (same as rsha256_fast() in BENCHMARK.md)
+static const local_tunedvariant local_variants[3] = {
+ { "base",   &local_Fast<false,1> },
+ { "msg",    &local_Fast<true,1>  },
+ { "unroll", &local_Fast<false,2> },
+ };
+
+//-- CPU key: MIDR implementer (31-24) and part number (15-4), 0 if unknown
+#define TUNED_KEY(implementer,part) (((uint32_t)(implementer) << 24) | ((uint32_t)(part) << 4))
+
+//-- calibrated CPU keys, best variant measured on core
+static std::mutex local_callock;
+static uint32_t   local_calkeys[RSHA256_TUNED_CALIBRATED];
+static uint32_t   local_calvariants[RSHA256_TUNED_CALIBRATED];
+static uint32_t   local_calcount = 0;
+
+//-- variant of calling thread, selected at first call
+static thread_local const local_tunedvariant* local_selected = NULL;
+
+//-- local_CpuKey() - CPU key of core running calling thread
+static uint32_t local_CpuKey(void)
+{
+ uint64_t midr = 0;
+#if defined(__linux__) && defined(__aarch64__)
+ __asm__ __volatile__("mrs %0, midr_el1" : "=r"(midr));
+#endif
+ return (uint32_t)midr & 0xFF00FFF0;
+}
+
+//-- local_Calibrate() - time all variants on core of calling thread, best kept for CPU key (lock held)
+static uint32_t local_Calibrate(
+const uint32_t key,
+const uint64_t iters)
+{
+ uint32_t best = 0;
+ double   best_time = 0.0;
+ alignas(32) uint8_t hash[32] = {0};
+
+ for(uint32_t v = 0; v < sizeof(local_variants) / sizeof(local_variants[0]); ++v){
+   double vtime = 0.0;
+   for(int run = 0; run < 3; ++run){
+     const auto t0 = std::chrono::steady_clock::now();
+     local_variants[v].func(hash,iters);
+     const auto t1 = std::chrono::steady_clock::now();
+     const double t = std::chrono::duration<double>(t1 - t0).count();
+     if(run == 0 || t < vtime){ vtime = t; }
+     }
+   if(best_time == 0.0 || vtime < best_time){ best = v; best_time = vtime; }
+   }
+
+ //-- keep for CPU key, replace earlier calibration of same key
+ uint32_t i = 0;
+ while(i < local_calcount && local_calkeys[i] != key){ ++i; }
+ if(i < RSHA256_TUNED_CALIBRATED){
+   local_calkeys[i] = key;
+   local_calvariants[i] = best;
+   if(i == local_calcount){ ++local_calcount; }
+   }
+ return best;
+}
+
+//-- rsha256_tuned_select() - (re)select variant for core of calling thread, return variant name
+const char* rsha256_tuned_select(
+uint32_t* cpu_key) //-- output CPU key of core, or NULL
+{
+ const uint32_t key = local_CpuKey();
+
+ //-- variant calibrated for CPU key, 1st select of a key calibrates (once per key and process)
+ //-- default if no room for more keys
+ uint32_t variant = 0;
+ {
+ std::lock_guard<std::mutex> guard(local_callock);
+ uint32_t i = 0;
+ while(i < local_calcount && local_calkeys[i] != key){ ++i; }
+ if(i < local_calcount){ variant = local_calvariants[i]; }
+ else if(i < RSHA256_TUNED_CALIBRATED){ variant = local_Calibrate(key,RSHA256_TUNED_ITERS); }
+ }
+
+ local_selected = &local_variants[variant];
+ if(cpu_key != NULL){ *cpu_key = key; }
+ return local_selected->name;
+}
+
+//-- rsha256_tuned_calibrate() - time all variants on core of calling thread, best kept for its CPU key
+const char* rsha256_tuned_calibrate(
+const uint64_t num_iters) //-- iterations per variant and run (best of 3x), 0 = RSHA256_TUNED_ITERS
+{
+ const uint32_t key = local_CpuKey();
+ uint32_t best;
+ {
+ std::lock_guard<std::mutex> guard(local_callock);
+ best = local_Calibrate(key,(num_iters > 0) ? num_iters : RSHA256_TUNED_ITERS);
+ }
+
+ local_selected = &local_variants[best];
+ return local_selected->name;
+}
+
+void rsha256_tuned(       //-- no return value, result to *hash
+uint8_t*       hash,      //-- input/output 32bytes hash/data SHA256 value
+const uint64_t num_iters) //-- number of times to SHA256 32bytes given in *hash
+{
+ if(local_selected == NULL){ rsha256_tuned_select(NULL); }
+ local_selected->func(hash,num_iters);
+}
+
+#endif
+
+// <eof>
@@ -0,0 +1,418 @@
+/*
+ * File: rsha256_tuned_x64.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Fast recursive SHA256 variants, with intrinsics and Intel SHA Extensions
+ * Variant calibrated per core type (CPUID vendor/family/model + hybrid core type)
+ *
+ * rsha256_tuned() - Same as rsha256_fast(), variant of calling thread's core
+ * rsha256_tuned_select() - (Re)select variant for calling thread's core
+ * rsha256_tuned_calibrate() - Time all variants on calling thread's core
+ *
+ * Variants differ in encoding (SSE vs VEX), instruction order (msg2 in
+ * between rnds2, or message schedule ahead of rounds) and unroll (1x or
+ * 2x iterations per loop trip). Same result, different scheduling in core.
+ *
+ * Encoding: GCC/Clang, VEX variants per function target("avx"), SSE
+ * variants only if this file is compiled without -mavx (e.g. -msse4.1
+ * -msha). MSVC, encoding of translation unit (/arch:AVX or not).
+ *
+ * Table of calibrated CPU keys picks variant. 1st select on a core type not
+ * in table (1st rsha256_tuned() of a thread) times all variants, fastest
+ * kept for its key, once per key and process. Default variant is avx
+ * (encoding of BENCHMARK.md builds) if table is full. Hybrid CPU, pin
+ * thread (rsha256_isolate()) before select/calibrate.
+ *
+ * Requirement: Intel/AMD x64 CPU, with SHA Extensions
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <stdint.h>
+
+#include <chrono>
+#include <mutex>
+
+#if defined(__amd64__) || defined(_M_AMD64)
+#include <immintrin.h>
+#endif
+
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#if defined(__amd64__) || defined(_M_AMD64)
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(__amd64__) || defined(_M_AMD64)
+
+//-- encoding of variants, SSE only if translation unit is not VEX
+#if defined(__AVX__)
+#define TUNED_HAS_SSE 0
+#else
+#define TUNED_HAS_SSE 1
+#endif
+#if defined(__AVX__) || defined(__GNUC__)
+#define TUNED_HAS_AVX 1
+#else
+#define TUNED_HAS_AVX 0
+#endif
+
+#if defined(__GNUC__)
+#define TUNED_SSE __attribute__((target("sse4.1,sha")))
+#define TUNED_AVX __attribute__((target("avx,sha")))
+#define TUNED_INLINE inline __attribute__((always_inline))
+#else
+#define TUNED_SSE
+#define TUNED_AVX
+#define TUNED_INLINE __forceinline
+#endif
+
+//-- max number of CPU keys calibrated in 1x process
+#ifndef RSHA256_TUNED_CALIBRATED
+#define RSHA256_TUNED_CALIBRATED 16
+#endif
+
+//-- iterations per variant and run of calibration (best of 3x)
+#ifndef RSHA256_TUNED_ITERS
+#define RSHA256_TUNED_ITERS 250000
+#endif
+
+//-- array of 64x constants for SHA256 rounds
+alignas(64) static const uint32_t K64[64] = {
+  0x428A2F98,0x71374491,0xB5C0FBCF,0xE9B5DBA5,0x3956C25B,0x59F111F1,0x923F82A4,0xAB1C5ED5,
+  0xD807AA98,0x12835B01,0x243185BE,0x550C7DC3,0x72BE5D74,0x80DEB1FE,0x9BDC06A7,0xC19BF174,
+  0xE49B69C1,0xEFBE4786,0x0FC19DC6,0x240CA1CC,0x2DE92C6F,0x4A7484AA,0x5CB0A9DC,0x76F988DA,
+  0x983E5152,0xA831C66D,0xB00327C8,0xBF597FC7,0xC6E00BF3,0xD5A79147,0x06CA6351,0x14292967,
+  0x27B70A85,0x2E1B2138,0x4D2C6DFC,0x53380D13,0x650A7354,0x766A0ABB,0x81C2C92E,0x92722C85,
+  0xA2BFE8A1,0xA81A664B,0xC24B8B70,0xC76C51A3,0xD192E819,0xD6990624,0xF40E3585,0x106AA070,
+  0x19A4C116,0x1E376C08,0x2748774C,0x34B0BCB5,0x391C0CB3,0x4ED8AA4A,0x5B9CCA4F,0x682E6FF3,
+  0x748F82EE,0x78A5636F,0x84C87814,0x8CC70208,0x90BEFFFA,0xA4506CEB,0xBEF9A3F7,0xC67178F2
+  };
+
+//-- 4x rounds, message msgtmp0, msg2 into msgtmp1 and msg1 into msgtmp3 if set
+//-- MSGFIRST: message schedule ahead of rnds2, else msg2 in between (rsha256_fast())
+#define TUNED_ROUND(msgtmp0, msgtmp1, msgtmp2, msgtmp3, kindex, domsg2, domsg1) \
+  if(MSGFIRST){ \
+    if(domsg2){ \
+      msgtmp1 = _mm_add_epi32(msgtmp1,_mm_alignr_epi8(msgtmp0,msgtmp3,4)); \
+      msgtmp1 = _mm_sha256msg2_epu32(msgtmp1,msgtmp0); } \
+    MSGV = _mm_add_epi32(msgtmp0,_mm_load_si128((const __m128i*)(&K64[kindex]))); \
+    STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV); \
+    MSGV = _mm_shuffle_epi32(MSGV,0x0E); \
+    STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV); \
+    if(domsg1){ msgtmp3 = _mm_sha256msg1_epu32(msgtmp3,msgtmp0); } \
+    } \
+  else{ \
+    MSGV = _mm_add_epi32(msgtmp0,_mm_load_si128((const __m128i*)(&K64[kindex]))); \
+    STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV); \
+    if(domsg2){ \
+      msgtmp1 = _mm_add_epi32(msgtmp1,_mm_alignr_epi8(msgtmp0,msgtmp3,4)); \
+      msgtmp1 = _mm_sha256msg2_epu32(msgtmp1,msgtmp0); } \
+    MSGV = _mm_shuffle_epi32(MSGV,0x0E); \
+    STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV); \
+    if(domsg1){ msgtmp3 = _mm_sha256msg1_epu32(msgtmp3,msgtmp0); } \
+    }
+
+//-- local_Iter() - 1x iteration, SHA256 of 32bytes in HASH0_SAVE/HASH1_SAVE
+template<bool MSGFIRST>
+TUNED_SSE static TUNED_INLINE void local_Iter(
+__m128i& HASH0_SAVE,
+__m128i& HASH1_SAVE)
+{
+ //-- pre-arranged/shuffled state values for SHA256 rounds, A-H logic
+ const __m128i ABEF_INIT = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ const __m128i CDGH_INIT = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+
+ //-- init state value for SHA256 rounds
+ __m128i STATE0 = ABEF_INIT;
+ __m128i STATE1 = CDGH_INIT;
+ __m128i MSGV;
+
+ //-- 1x block, hash + pre-arranged/shuffled SHA256 padding logic
+ __m128i MSGTMP0 = HASH0_SAVE;
+ __m128i MSGTMP1 = HASH1_SAVE;
+ __m128i MSGTMP2 = _mm_set_epi64x(0x0000000000000000,0x0000000080000000);
+ __m128i MSGTMP3 = _mm_set_epi64x(0x0000010000000000,0x0000000000000000);
+
+ //-- rounds 0-3, 4-7, 8-11, 12-15
+ TUNED_ROUND(MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3, 0,0,0);
+ TUNED_ROUND(MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0, 4,0,1);
+ TUNED_ROUND(MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1, 8,0,1);
+ TUNED_ROUND(MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,12,1,1);
+
+ //-- rounds 16-19, 20-23, 24-27, 28-31
+ TUNED_ROUND(MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,16,1,1);
+ TUNED_ROUND(MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0,20,1,1);
+ TUNED_ROUND(MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1,24,1,1);
+ TUNED_ROUND(MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,28,1,1);
+
+ //-- rounds 32-35, 36-39, 40-43, 44-47
+ TUNED_ROUND(MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,32,1,1);
+ TUNED_ROUND(MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0,36,1,1);
+ TUNED_ROUND(MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1,40,1,1);
+ TUNED_ROUND(MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,44,1,1);
+
+ //-- rounds 48-51, 52-55, 56-59, 60-63
+ TUNED_ROUND(MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,48,1,1);
+ TUNED_ROUND(MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0,52,1,0);
+ TUNED_ROUND(MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1,56,1,0);
+ TUNED_ROUND(MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,60,0,0);
+
+ //-- add init state to current state
+ STATE0 = _mm_add_epi32(STATE0,ABEF_INIT);
+ STATE1 = _mm_add_epi32(STATE1,CDGH_INIT);
+
+ //-- shuffle state, save for next iteration or final result
+ STATE0 = _mm_shuffle_epi32(STATE0,0x1B); // FEBA
+ STATE1 = _mm_shuffle_epi32(STATE1,0xB1); // DCHG
+ HASH0_SAVE = _mm_blend_epi16(STATE0,STATE1,0xF0); // DCBA
+ HASH1_SAVE = _mm_alignr_epi8(STATE1,STATE0,8);    // HGFE
+}
+
+//-- local_Fast() - loop of rsha256_fast(), instruction order and unroll at compile time
+template<bool MSGFIRST, uint32_t UNROLL>
+TUNED_SSE static TUNED_INLINE void local_Fast(
+uint8_t*       hash,
+const uint64_t num_iters)
+{
+ //-- if 0 iterations, result is input hash/data
+ if(num_iters <= 0) return;
+
+ //-- shuffle mask for byte order required by SHA Extensions
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+
+ //-- variables to init/keep hash value through SHA256 rounds, shuffled for SHA Extensions
+ __m128i HASH0_SAVE = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(&hash[0])),SHUF_MASK);
+ __m128i HASH1_SAVE = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(&hash[16])),SHUF_MASK);
+
+ //-- UNROLL iterations per loop trip, rest 1x at a time
+ uint64_t i = 0;
+ for(; i + UNROLL <= num_iters; i += UNROLL){
+   local_Iter<MSGFIRST>(HASH0_SAVE,HASH1_SAVE);
+   if(UNROLL > 1){ local_Iter<MSGFIRST>(HASH0_SAVE,HASH1_SAVE); }
+   }
+ for(; i < num_iters; ++i){ local_Iter<MSGFIRST>(HASH0_SAVE,HASH1_SAVE); }
+
+ //-- shuffle SHA Extensions hash value back, copy/return final hash value into *hash
+ _mm_storeu_si128((__m128i*)(&hash[0]),_mm_shuffle_epi8(HASH0_SAVE,SHUF_MASK));
+ _mm_storeu_si128((__m128i*)(&hash[16]),_mm_shuffle_epi8(HASH1_SAVE,SHUF_MASK));
+}
+
+//-- variants, encoding by function target
+#if TUNED_HAS_SSE
+TUNED_SSE static void local_FastSse(uint8_t* hash, const uint64_t num_iters){ local_Fast<false,1>(hash,num_iters); }
+TUNED_SSE static void local_FastSseMsg(uint8_t* hash, const uint64_t num_iters){ local_Fast<true,1>(hash,num_iters); }
+TUNED_SSE static void local_FastSseU2(uint8_t* hash, const uint64_t num_iters){ local_Fast<false,2>(hash,num_iters); }
+#endif
+#if TUNED_HAS_AVX
+TUNED_AVX static void local_FastAvx(uint8_t* hash, const uint64_t num_iters){ local_Fast<false,1>(hash,num_iters); }
+TUNED_AVX static void local_FastAvxMsg(uint8_t* hash, const uint64_t num_iters){ local_Fast<true,1>(hash,num_iters); }
+TUNED_AVX static void local_FastAvxU2(uint8_t* hash, const uint64_t num_iters){ local_Fast<false,2>(hash,num_iters); }
+#endif
+
+typedef void (*local_fastfunc)(uint8_t*,const uint64_t);
+
+struct local_tunedvariant {
+ const char*    name;
+ local_fastfunc func;   //-- NULL if not compiled in
+ bool           avx;    //-- needs AVX enabled by CPU/OS
+};
+
+//-- index 0 is default without AVX, index 3 default with AVX (same as rsha256_fast() in BENCHMARK.md)
+static const local_tunedvariant local_variants[6] = {
+#if TUNED_HAS_SSE
+ { "sse",        &local_FastSse,    false },
+ { "sse-msg",    &local_FastSseMsg, false },
+ { "sse-unroll", &local_FastSseU2,  false },
+#else
+ { "sse",        NULL, false },
+ { "sse-msg",    NULL, false },
+ { "sse-unroll", NULL, false },
+#endif
+#if TUNED_HAS_AVX
+ { "avx",        &local_FastAvx,    true },
+ { "avx-msg",    &local_FastAvxMsg, true },
+ { "avx-unroll", &local_FastAvxU2,  true },
+#else
+ { "avx",        NULL, true },
+ { "avx-msg",    NULL, true },
+ { "avx-unroll", NULL, true },
+#endif
+ };
+
+//-- CPU key: vendor (31-28), hybrid core type (27-20), family (19-8), model (7-0)
+#define TUNED_INTEL 0x1
+#define TUNED_AMD   0x2
+#define TUNED_KEY(vendor,coretype,family,model) \
+  (((uint32_t)(vendor) << 28) | ((uint32_t)(coretype) << 20) | ((uint32_t)(family) << 8) | (uint32_t)(model))
+
+//-- calibrated CPU keys, best variant measured on core
+static std::mutex local_callock;
+static uint32_t   local_calkeys[RSHA256_TUNED_CALIBRATED];
+static uint32_t   local_calvariants[RSHA256_TUNED_CALIBRATED];
+static uint32_t   local_calcount = 0;
+
+//-- variant of calling thread, selected at first call
+static thread_local const local_tunedvariant* local_selected = NULL;
+
+//-- local_Cpuid() - CPUID leaf/subleaf into regs[4] (eax, ebx, ecx, edx)
+static void local_Cpuid(
+uint32_t*      regs,
+const uint32_t leaf,
+const uint32_t subleaf)
+{
+#ifdef _WIN32
+ int info[4];
+ __cpuidex(info,(int)leaf,(int)subleaf);
+ for(int i = 0; i < 4; ++i){ regs[i] = (uint32_t)info[i]; }
+#else
+ __cpuid_count(leaf,subleaf,regs[0],regs[1],regs[2],regs[3]);
+#endif
+}
+
+//-- local_Xgetbv() - XCR0, state enabled by OS
+static uint64_t local_Xgetbv(void)
+{
+#ifdef _WIN32
+ return _xgetbv(0);
+#else
+ uint32_t lo, hi;
+ __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+ return ((uint64_t)hi << 32) | lo;
+#endif
+}
+
+//-- local_CpuKey() - CPU key of core running calling thread, *avx true if AVX enabled by CPU/OS
+static uint32_t local_CpuKey(
+bool* avx)
+{
+ uint32_t regs[4];
+ local_Cpuid(regs,0,0);
+ const uint32_t maxleaf = regs[0];
+ uint32_t vendor = 0;
+ if(regs[1] == 0x756E6547 && regs[3] == 0x49656E69 && regs[2] == 0x6C65746E){ vendor = TUNED_INTEL; } //-- GenuineIntel
+ if(regs[1] == 0x68747541 && regs[3] == 0x69746E65 && regs[2] == 0x444D4163){ vendor = TUNED_AMD; }   //-- AuthenticAMD
+
+ //-- display family/model, extended fields added for family 0x0F (and model for 0x06)
+ local_Cpuid(regs,1,0);
+ uint32_t family = (regs[0] >> 8) & 0x0F;
+ uint32_t model = (regs[0] >> 4) & 0x0F;
+ if(family == 0x0F){ family += (regs[0] >> 20) & 0xFF; }
+ if(family == 0x06 || family >= 0x0F){ model |= ((regs[0] >> 16) & 0x0F) << 4; }
+
+ //-- AVX and OSXSAVE, and XMM/YMM state enabled by OS
+ *avx = false;
+ if((regs[2] & (1u << 28)) && (regs[2] & (1u << 27))){ *avx = ((local_Xgetbv() & 0x6) == 0x6); }
+
+ //-- hybrid core type, leaf 0x1A on CPUs with hybrid flag (leaf 7, edx bit 15)
+ uint32_t coretype = 0;
+ if(maxleaf >= 0x1A){
+   local_Cpuid(regs,7,0);
+   if(regs[3] & (1u << 15)){
+     local_Cpuid(regs,0x1A,0);
+     coretype = regs[0] >> 24;
+     }
+   }
+
+ return TUNED_KEY(vendor,coretype,family,model);
+}
+
+//-- local_Usable() - variant compiled in, and AVX enabled if needed
+static bool local_Usable(
+const uint32_t variant,
+const bool     avx)
+{
+ return (local_variants[variant].func != NULL && (avx || !local_variants[variant].avx));
+}
+
+//-- local_Calibrate() - time all variants on core of calling thread, best kept for CPU key (lock held)
+static uint32_t local_Calibrate(
+const uint32_t key,
+const bool     avx,
+const uint64_t iters)
+{
+ uint32_t best = local_Usable(3,avx) ? 3 : 0;
+ double   best_time = 0.0;
+ alignas(32) uint8_t hash[32] = {0};
+
+ for(uint32_t v = 0; v < sizeof(local_variants) / sizeof(local_variants[0]); ++v){
+   if(!local_Usable(v,avx)){ continue; }
+   double vtime = 0.0;
+   for(int run = 0; run < 3; ++run){
+     const auto t0 = std::chrono::steady_clock::now();
+     local_variants[v].func(hash,iters);
+     const auto t1 = std::chrono::steady_clock::now();
+     const double t = std::chrono::duration<double>(t1 - t0).count();
+     if(run == 0 || t < vtime){ vtime = t; }
+     }
+   if(best_time == 0.0 || vtime < best_time){ best = v; best_time = vtime; }
+   }
+
+ //-- keep for CPU key, replace earlier calibration of same key
+ uint32_t i = 0;
+ while(i < local_calcount && local_calkeys[i] != key){ ++i; }
+ if(i < RSHA256_TUNED_CALIBRATED){
+   local_calkeys[i] = key;
+   local_calvariants[i] = best;
+   if(i == local_calcount){ ++local_calcount; }
+   }
+ return best;
+}
+
+//-- rsha256_tuned_select() - (re)select variant for core of calling thread, return variant name
+const char* rsha256_tuned_select(
+uint32_t* cpu_key) //-- output CPU key of core, or NULL
+{
+ bool avx;
+ const uint32_t key = local_CpuKey(&avx);
+
+ //-- variant calibrated for CPU key, 1st select of a key calibrates (once per key and process)
+ //-- default if no room for more keys, same encoding as BENCHMARK.md builds if available
+ uint32_t variant = local_Usable(3,avx) ? 3 : 0;
+ {
+ std::lock_guard<std::mutex> guard(local_callock);
+ uint32_t i = 0;
+ while(i < local_calcount && local_calkeys[i] != key){ ++i; }
+ if(i < local_calcount){ variant = local_calvariants[i]; }
+ else if(i < RSHA256_TUNED_CALIBRATED){ variant = local_Calibrate(key,avx,RSHA256_TUNED_ITERS); }
+ }
+
+ local_selected = &local_variants[variant];
+ if(cpu_key != NULL){ *cpu_key = key; }
+ return local_selected->name;
+}
+
+//-- rsha256_tuned_calibrate() - time all variants on core of calling thread, best kept for its CPU key
+const char* rsha256_tuned_calibrate(
+const uint64_t num_iters) //-- iterations per variant and run (best of 3x), 0 = RSHA256_TUNED_ITERS
+{
+ bool avx;
+ const uint32_t key = local_CpuKey(&avx);
+ uint32_t best;
+ {
+ std::lock_guard<std::mutex> guard(local_callock);
+ best = local_Calibrate(key,avx,(num_iters > 0) ? num_iters : RSHA256_TUNED_ITERS);
+ }
+
+ local_selected = &local_variants[best];
+ return local_selected->name;
+}
+
+void rsha256_tuned(       //-- no return value, result to *hash
+uint8_t*       hash,      //-- input/output 32bytes hash/data SHA256 value
+const uint64_t num_iters) //-- number of times to SHA256 32bytes given in *hash
+{
+ if(local_selected == NULL){ rsha256_tuned_select(NULL); }
+ local_selected->func(hash,num_iters);
+}
+
+#endif
+
+// <eof>
@@ -0,0 +1,146 @@
+/*
+ * File: monitor_tl.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Monitor of VDF creation (TimeLord), reads shared-memory live telemetry
+ * No syscall, lock or signal towards creation process/core
+ *
+ * Program call: monitor_tl -n <name> -m <ms> -c <count>
+ *
+ * -n <name>: Name of telemetry segment, as given to rsha256_telem_open() (optional)
+ *            Default: /rsha256tl
+ *
+ * -m <ms>: Milliseconds between samples (optional)
+ *          Default: 1000
+ *
+ * -c <count>: Number of samples, then exit (optional)
+ *             Default: 0 (until creator gone, or Ctrl-C)
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <thread>
+
+#include "rsha256tl.h"
+
+//-- local functions
+void local_ANSISetup(void);
+void local_ANSIRestore(void);
+void local_ParseParameters(int argc,char* argv[]);
+
+//-- local parameter values
+const char* local_name;
+uint64_t    local_ms;
+uint64_t    local_count;
+
+//-- main() - entrypoint
+int main(int argc, char* argv[])
+{
+
+ //-- setup/init ANSI capability
+ local_ANSISetup();
+
+ //-- default parameter values, -n /rsha256tl, -m 1000, -c 0
+ local_name = "/rsha256tl";
+ local_ms = 1000;
+ local_count = 0;
+
+ //-- display header
+ setvbuf(stdout,NULL,_IONBF,0);
+ printf("\33[1;97m[Monitor (tl) - VDF Creation, live telemetry]\33[0m\n");
+
+ //-- parse parameters
+ local_ParseParameters(argc,argv);
+
+ //-- attach to telemetry segment
+ rsha256_telem* telem = rsha256_telem_attach(local_name);
+ if(telem == NULL){ fprintf(stderr,"\33[1;31mERROR: Telemetry segment %s not found !\33[0m\n",local_name); local_ANSIRestore(); return 1; }
+ printf("- Parameters: %s (segment), %" PRIu64 " ms (interval)\n",local_name,local_ms);
+
+ //-- sample until count, or creator gone (no update within 10x interval and 10s)
+ uint64_t samples = 0;
+ int      ret = 0;
+ while(local_count == 0 || samples < local_count){
+   rsha256_telemsample sample;
+   if(!rsha256_telem_read(telem,&sample)){ fprintf(stderr,"\33[1;31mERROR: Telemetry segment %s not valid !\33[0m\n",local_name); ret = 1; break; }
+
+   const uint64_t now = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+   const double   age = (now > sample.time_ns) ? (double)(now - sample.time_ns) / 1e6 : 0.0;
+
+   printf("- pid %u: %10.2f MH \33[1;32m%6.2f\33[0m MH/s, %" PRIu64 " cp, %02X%02X%02X%02X.., updated %.0f ms ago\n",
+          sample.pid,(double)sample.iters_done / 1000000.0,sample.mhs,sample.cp_num,sample.hash[0],sample.hash[1],sample.hash[2],sample.hash[3],age);
+
+   if(++samples == local_count){ break; }
+   if(age > 10.0 * (double)local_ms && age > 10000.0){ printf("- Creator stopped updating, exit\n"); break; }
+   std::this_thread::sleep_for(std::chrono::milliseconds(local_ms));
+   }
+
+ rsha256_telem_close(telem);
+
+ //-- restore ANSI capability
+ local_ANSIRestore();
+
+ return ret;
+}
+
+//-- local_ParseParameters() - parse parameters
+void local_ParseParameters(int argc,char* argv[])
+{
+ for(int i = 1, jP = 0; i < argc; ++i){
+   if((char)jP == 'n'){
+     local_name = argv[i];
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 'm'){
+     local_ms = strtoull(argv[i],NULL,10);
+     if(local_ms < 1){ local_ms = 1; }
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 'c'){
+     local_count = strtoull(argv[i],NULL,10);
+     jP = 0; continue;
+     }
+
+   jP = 0;
+   if(!strcmp(argv[i],"-n")){ jP = 'n'; continue; }
+   if(!strcmp(argv[i],"-m")){ jP = 'm'; continue; }
+   if(!strcmp(argv[i],"-c")){ jP = 'c'; continue; }
+   }
+}
+
+//-- local_ANSISetup() - setup/init ANSI capability (needed for Windows)
+//-- local_ANSIRestore() - restore ANSI capability (needed for Windows)
+#ifdef _WIN32
+#include <windows.h>
+static HANDLE local_win_stdout;
+static DWORD  local_win_savemode = 0;
+void local_ANSISetup(void)
+{
+ local_win_stdout = GetStdHandle(STD_OUTPUT_HANDLE);
+ if(local_win_stdout == INVALID_HANDLE_VALUE){ return; }
+ if(!GetConsoleMode(local_win_stdout,&local_win_savemode)){ local_win_savemode = 0; return; }
+ if(!SetConsoleMode(local_win_stdout,(local_win_savemode | ENABLE_VIRTUAL_TERMINAL_PROCESSING))){ local_win_savemode = 0; return; }
+}
+void local_ANSIRestore(void)
+{
+ if(!SetConsoleMode(local_win_stdout,local_win_savemode)){ return; }
+}
+#else
+void local_ANSISetup(void) {}
+void local_ANSIRestore(void) {}
+#endif
+
+// <eof>
@@ -0,0 +1,321 @@
+/*
+ * File: rsha256tl.h
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Declarations for VDF creation (TimeLord) with fast recursive SHA256
+ *
+ * rsha256tl_x64.cxx - Creation, checkpoint emitting (Intel/AMD)
+ * rsha256tl_arm.cxx - Creation, checkpoint emitting (ARM)
+ * rsha256tl_ring.cxx - Lock-free SPSC ring of checkpoints
+ * rsha256tl_snap.cxx - Crash-safe snapshots of creation state, resume
+ * rsha256tl_telem.cxx - Shared-memory live telemetry of creation
+ * rsha256tl_isolate.cxx - Isolation of creation thread, noise checks
+ * rsha256tl_hist.cxx - Per-chunk latency/jitter histogram of creation
+ * rsha256tl_shadow.cxx - Shadow verification of live creation, rollback on fault
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#ifndef RSHA256TL_H
+#define RSHA256TL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+//-- called at each checkpoint, outside of inner loop, return false to stop creation
+typedef bool (*rsha256_cpfunc)(void* cp_ctx, const uint64_t cp_iters_done, const uint8_t* cp_hash);
+
+//-- VDF creation, checkpoint emitting (rsha256tl_*.cxx)
+uint64_t rsha256_create(   //-- return number of iterations done, less than num_iters if stopped by cp_func
+uint8_t*       hash,       //-- input/output 32bytes hash/data SHA256 value
+const uint64_t num_iters,  //-- number of times to SHA256 32bytes given in *hash
+const uint64_t cp_iters,   //-- number of iterations between checkpoints, 0 = none
+uint8_t*       cp_hashes,  //-- output num_iters / cp_iters x 32bytes checkpoint values (optional, NULL)
+rsha256_cpfunc cp_func,    //-- called at each checkpoint, return false to stop (optional, NULL)
+void*          cp_ctx);    //-- context given to cp_func
+
+//-- checkpoint output of 1x chain, buffer and/or callback
+struct rsha256_cpout {
+ uint8_t*       cp_hashes;  //-- output num_iters / cp_iters x 32bytes checkpoint values (optional, NULL)
+ rsha256_cpfunc cp_func;    //-- called at each checkpoint, return false to stop (optional, NULL)
+ void*          cp_ctx;     //-- context given to cp_func
+};
+
+//-- VDF creation, 2x independent chains in lockstep on 1x core (rsha256tl_*.cxx)
+uint64_t rsha256_create_x2(     //-- return number of iterations done (each chain), less than num_iters if stopped by a cp_func
+uint8_t*             hash,      //-- input/output 64 bytes, 2x 32bytes hash/data SHA256 values
+const uint64_t       num_iters, //-- number of times to SHA256 2x 32bytes given in *hash
+const uint64_t       cp_iters,  //-- number of iterations between checkpoints, 0 = none
+const rsha256_cpout* cp_out);   //-- 2x checkpoint outputs, 1x per chain (optional, NULL)
+
+//-- queue of verify segments, for fused creation + verification (rsha256tl_*.cxx)
+#define RSHA256_FUSED_FAIL     0 //-- segment end hash/data do not match
+#define RSHA256_FUSED_OK       1 //-- segment verified ok
+#define RSHA256_FUSED_ABORTED -1 //-- creation ended before segment verified, submit again
+
+struct rsha256_fusedq;
+
+rsha256_fusedq* rsha256_fusedq_create( //-- return new queue
+const uint32_t  size);                 //-- number of segments in queue, rounded up to power of 2
+
+void rsha256_fusedq_destroy(    //-- no return value, queue freed
+rsha256_fusedq* queue);         //-- queue to free, creation done
+
+bool rsha256_fusedq_submit(     //-- return true if added, false if queue full
+rsha256_fusedq* queue,          //-- queue (submitter thread only)
+const uint8_t*  start,          //-- 32bytes hash/data SHA256 value at start of segment
+const uint8_t*  end,            //-- 32bytes hash/data SHA256 value expected at end of segment
+const uint64_t  iters,          //-- number of iterations in segment
+const uint64_t  id);            //-- id of segment, given back with result
+
+bool rsha256_fusedq_result(     //-- return true if result popped, false if none
+rsha256_fusedq* queue,          //-- queue (submitter thread only)
+uint64_t*       id,             //-- output id of segment (optional, NULL)
+int32_t*        status);        //-- output RSHA256_FUSED_OK/_FAIL/_ABORTED (optional, NULL)
+
+bool rsha256_fusedq_pull(       //-- return true if segment pulled, used by rsha256_create_fused()
+rsha256_fusedq* queue,          //-- queue (creation thread only)
+uint8_t*        start,          //-- output 32bytes start hash/data
+uint8_t*        end,            //-- output 32bytes expected end hash/data
+uint64_t*       iters,          //-- output number of iterations
+uint64_t*       id);            //-- output id of segment
+
+void rsha256_fusedq_push(       //-- no return value, result added, used by rsha256_create_fused()
+rsha256_fusedq* queue,          //-- queue (creation thread only)
+const uint64_t  id,             //-- id of segment
+const int32_t   status);        //-- RSHA256_FUSED_OK/_FAIL/_ABORTED
+
+//-- VDF creation in lane 1, verification of queued segments in lane 2, on 1x core (rsha256tl_*.cxx)
+uint64_t rsha256_create_fused(  //-- return number of iterations done, less than num_iters if stopped by cp_func
+uint8_t*        hash,           //-- input/output 32bytes hash/data SHA256 value (creation chain)
+const uint64_t  num_iters,      //-- number of times to SHA256 32bytes given in *hash
+const uint64_t  cp_iters,       //-- number of iterations between checkpoints, 0 = none
+uint8_t*        cp_hashes,      //-- output num_iters / cp_iters x 32bytes checkpoint values (optional, NULL)
+rsha256_cpfunc  cp_func,        //-- called at each checkpoint, return false to stop (optional, NULL)
+void*           cp_ctx,         //-- context given to cp_func
+rsha256_fusedq* queue);         //-- segments to verify in lane 2, results back (optional, NULL)
+
+double rsha256_fused_calibrate( //-- return per-chain rate of x2 kernel vs x1 kernel, 1.0 = creation lane keeps full speed
+const uint64_t num_iters);      //-- number of iterations per measurement, 0 = 1M
+
+//-- VDF creation until deadline, chunks adapt to measured rate (rsha256tl_*.cxx)
+uint64_t rsha256_deadline(     //-- return deadline for rsha256_create_until(), steady clock ns
+const double seconds);         //-- time budget from now, seconds
+
+uint64_t rsha256_create_until( //-- return number of iterations done, at deadline or stopped by cp_func
+uint8_t*       hash,           //-- input/output 32bytes hash/data SHA256 value
+const uint64_t deadline_ns,    //-- deadline, steady clock ns (rsha256_deadline())
+const uint64_t overshoot_us,   //-- max time past deadline, microseconds
+const uint64_t cp_iters,       //-- number of iterations between checkpoints, 0 = none
+rsha256_cpfunc cp_func,        //-- called at each checkpoint, return false to stop (optional, NULL)
+void*          cp_ctx);        //-- context given to cp_func
+
+//-- external data infused into chain, iteration is SHA256(hash||data) instead of SHA256(hash)
+#ifndef RSHA256_INFUSION_DEFINED
+#define RSHA256_INFUSION_DEFINED
+struct rsha256_infusion {
+ uint64_t iter;                //-- iteration of chain (1 = first after chain start) computed as SHA256(hash||data)
+ uint8_t  data[32];            //-- 32bytes data, 2nd half of 64bytes message
+};
+#endif
+
+//-- VDF creation with infusions, plain loop between infusion points (rsha256tl_*.cxx)
+uint64_t rsha256_create_infused(  //-- return number of iterations done, less than num_iters if stopped by cp_func, 0 if schedule not ascending
+uint8_t*                hash,           //-- input/output 32bytes hash/data SHA256 value
+const uint64_t          num_iters,      //-- number of times to SHA256 given in *hash (infusions included)
+const uint64_t          cp_iters,       //-- number of iterations between checkpoints, 0 = none
+uint8_t*                cp_hashes,      //-- output num_iters / cp_iters x 32bytes checkpoint values (optional, NULL)
+rsha256_cpfunc          cp_func,        //-- called at each checkpoint, return false to stop (optional, NULL)
+void*                   cp_ctx,         //-- context given to cp_func
+const uint64_t          start_iters,    //-- iteration of chain at *hash, infusion schedule counted from chain start
+const rsha256_infusion* infusions,      //-- infusion schedule, ascending by iteration, 1x per iteration (optional, NULL)
+const uint32_t          num_infusions); //-- number of infusions in *infusions
+
+//-- lock-free single-producer/single-consumer ring of checkpoints (rsha256tl_ring.cxx)
+struct rsha256_cpring;
+
+rsha256_cpring* rsha256_cpring_create( //-- return new ring
+const uint32_t  size);                 //-- number of checkpoints in ring, rounded up to power of 2
+
+void rsha256_cpring_destroy(    //-- no return value, ring freed
+rsha256_cpring* ring);          //-- ring to free, producer/consumer done
+
+void rsha256_cpring_push(       //-- no return value, spins if ring full (never drops)
+rsha256_cpring* ring,           //-- ring to push to (producer thread only)
+const uint64_t  cp_iters_done,  //-- number of iterations done at checkpoint
+const uint8_t*  cp_hash);       //-- 32bytes hash/data SHA256 value at checkpoint
+
+bool rsha256_cpring_func(       //-- return true, rsha256_cpfunc adapter for rsha256_create()
+void*           cp_ctx,         //-- ring to push to (rsha256_cpring*)
+const uint64_t  cp_iters_done,  //-- number of iterations done at checkpoint
+const uint8_t*  cp_hash);       //-- 32bytes hash/data SHA256 value at checkpoint
+
+void rsha256_cpring_close(      //-- no return value, no more checkpoints from producer
+rsha256_cpring* ring);          //-- ring to close (producer thread only)
+
+bool rsha256_cpring_pop(        //-- return true if popped, false if empty (wait: closed and empty)
+rsha256_cpring* ring,           //-- ring to pop from (consumer thread only)
+uint64_t*       cp_iters_done,  //-- output number of iterations done at checkpoint (optional, NULL)
+uint8_t*        cp_hash,        //-- output 32bytes hash/data SHA256 value at checkpoint (optional, NULL)
+const bool      wait);          //-- true = wait until checkpoint available or ring closed
+
+uint64_t rsha256_cpring_stalls( //-- return number of times producer found ring full
+rsha256_cpring* ring);          //-- ring, call from producer thread or after close
+
+//-- crash-safe snapshots of creation state (rsha256tl_snap.cxx)
+struct rsha256_snapshot {
+ uint64_t iters_done;   //-- number of iterations done from start of chain
+ uint64_t cp_num;       //-- number of checkpoints done (last checkpoint index + 1)
+ uint8_t  hash[32];     //-- 32bytes hash/data SHA256 value after iters_done
+};
+
+struct rsha256_snapper;
+
+rsha256_snapper* rsha256_snap_start( //-- return new snapper, snapshot thread started
+const char*             path,        //-- snapshot file, <path>.tmp used while writing
+const uint64_t          interval_ms, //-- time between snapshots, written only if state changed
+const rsha256_snapshot* resume);     //-- state resumed from, base for rsha256_snap_func() (optional, NULL)
+
+void rsha256_snap_update(       //-- no return value, latest state published (never blocks)
+rsha256_snapper* snap,          //-- snapper to publish to (creation thread only)
+const uint64_t   iters_done,    //-- number of iterations done from start of chain
+const uint64_t   cp_num,        //-- number of checkpoints done
+const uint8_t*   hash);         //-- 32bytes hash/data SHA256 value after iters_done
+
+bool rsha256_snap_func(         //-- return true, rsha256_cpfunc adapter for rsha256_create()
+void*           cp_ctx,         //-- snapper to publish to (rsha256_snapper*)
+const uint64_t  cp_iters_done,  //-- number of iterations done at checkpoint, relative to resume
+const uint8_t*  cp_hash);       //-- 32bytes hash/data SHA256 value at checkpoint
+
+bool rsha256_snap_stop(         //-- return true if last snapshot write ok, snapper freed
+rsha256_snapper* snap);         //-- snapper to stop, final state written
+
+bool rsha256_snap_load(         //-- return true if snapshot file valid
+const char*       path,         //-- snapshot file
+rsha256_snapshot* state);       //-- output state to resume from
+
+//-- shared-memory live telemetry of creation (rsha256tl_telem.cxx)
+struct rsha256_telemsample {
+ uint32_t pid;          //-- process id of creator
+ uint64_t iters_done;   //-- number of iterations done
+ uint64_t cp_num;       //-- number of checkpoints done
+ double   mhs;          //-- MH/s since previous update
+ uint64_t time_ns;      //-- wall clock of update, ns since epoch
+ uint8_t  hash[32];     //-- 32bytes hash/data SHA256 value at last checkpoint
+};
+
+struct rsha256_telem;
+
+rsha256_telem* rsha256_telem_open( //-- return new telemetry, segment created (NULL if failed)
+const char* name);                 //-- segment name, "/name" (POSIX shm_open)
+
+void rsha256_telem_update(      //-- no return value, values published (never blocks)
+rsha256_telem*  telem,          //-- telemetry to publish to (creation thread only)
+const uint64_t  iters_done,     //-- number of iterations done
+const uint64_t  cp_num,         //-- number of checkpoints done
+const uint8_t*  hash);          //-- 32bytes hash/data SHA256 value at checkpoint (optional, NULL)
+
+bool rsha256_telem_func(        //-- return true, rsha256_cpfunc adapter for rsha256_create()
+void*           cp_ctx,         //-- telemetry to publish to (rsha256_telem*)
+const uint64_t  cp_iters_done,  //-- number of iterations done at checkpoint
+const uint8_t*  cp_hash);       //-- 32bytes hash/data SHA256 value at checkpoint
+
+rsha256_telem* rsha256_telem_attach( //-- return telemetry attached read-only (NULL if not found)
+const char* name);                   //-- segment name, "/name" (POSIX shm_open)
+
+bool rsha256_telem_read(        //-- return true if sample valid
+rsha256_telem*       telem,     //-- telemetry attached to
+rsha256_telemsample* sample);   //-- output consistent sample of latest values
+
+void rsha256_telem_close(       //-- no return value, detached, creator removes segment name
+rsha256_telem* telem);          //-- telemetry to close
+
+//-- isolation of creation thread (rsha256tl_isolate.cxx)
+uint32_t rsha256_isolate(       //-- return number of warnings, noise sources found or setup failed
+const int32_t cpu,              //-- CPU to pin calling thread to, -1 = CPU running on now
+const bool    mlock,            //-- mlockall() current and future pages
+const int32_t fifo_prio,        //-- SCHED_FIFO priority (1-99), 0 = not real-time
+char*         warnings,         //-- output warnings, 1x line each (optional, NULL)
+const size_t  warnings_len);    //-- size of warnings buffer
+
+//-- per-chunk latency/jitter histogram of creation (rsha256tl_hist.cxx)
+struct rsha256_hist;
+
+rsha256_hist* rsha256_hist_create(void); //-- return new histogram, tick counter calibrated
+
+void rsha256_hist_start(        //-- no return value, start of first chunk
+rsha256_hist* hist);            //-- histogram (creation thread only)
+
+void rsha256_hist_mark(         //-- no return value, end of chunk, duration since previous mark/start recorded
+rsha256_hist* hist);            //-- histogram (creation thread only)
+
+bool rsha256_hist_func(         //-- return true, rsha256_cpfunc adapter for rsha256_create(), 1x chunk per checkpoint
+void*           cp_ctx,         //-- histogram (rsha256_hist*)
+const uint64_t  cp_iters_done,  //-- number of iterations done at checkpoint
+const uint8_t*  cp_hash);       //-- 32bytes hash/data SHA256 value at checkpoint (not used)
+
+double rsha256_hist_percentile( //-- return chunk duration at percentile, seconds
+rsha256_hist* hist,             //-- histogram (any thread, any time)
+const double  percentile);      //-- percentile, 0.0-100.0
+
+void rsha256_hist_dump(         //-- no return value, summary and non-empty buckets printed
+rsha256_hist*  hist,            //-- histogram (any thread, any time)
+FILE*          fp,              //-- output, stdout/stderr/file
+const uint64_t chunk_iters);    //-- iterations per chunk for MH/s, 0 = from rsha256_hist_func()
+
+void rsha256_hist_reset(        //-- no return value, histogram cleared
+rsha256_hist* hist);            //-- histogram (creation thread not running)
+
+void rsha256_hist_destroy(      //-- no return value, histogram freed
+rsha256_hist* hist);            //-- histogram
+
+//-- shadow verification of live creation on other cores, rollback on fault (rsha256tl_shadow.cxx)
+struct rsha256_shadow;
+
+//-- called from verifier thread at first failing segment, chain ok up to good_iters
+typedef void (*rsha256_alertfunc)(void* alert_ctx, const uint64_t good_iters, const uint64_t bad_iters);
+
+rsha256_shadow* rsha256_shadow_start( //-- return new shadow, verifier thread and engine started (before pinning creator)
+const uint8_t*    start_hash,   //-- 32bytes hash/data SHA256 value at start_iters
+const uint64_t    start_iters,  //-- number of iterations done at start_hash, 0 = new chain
+const uint32_t    threads,      //-- number of verify threads, 0 = by CPU budget
+const uint32_t    ring_size,    //-- number of checkpoints in ring, 0 = 4096
+rsha256_alertfunc alert,        //-- called at first failing segment (optional, NULL)
+void*             alert_ctx);   //-- context given to alert
+
+bool rsha256_shadow_func(       //-- return false if fault, rsha256_cpfunc adapter for rsha256_create()
+void*           cp_ctx,         //-- shadow (rsha256_shadow*)
+const uint64_t  cp_iters_done,  //-- number of iterations done at checkpoint, since start/rollback
+const uint8_t*  cp_hash);       //-- 32bytes hash/data SHA256 value at checkpoint
+
+bool rsha256_shadow_fault(      //-- return true if a segment failed verification, not yet rolled back
+rsha256_shadow* shadow);        //-- shadow (any thread)
+
+uint64_t rsha256_shadow_rollback( //-- return number of iterations done at last good checkpoint
+rsha256_shadow* shadow,         //-- shadow (creation thread only)
+uint8_t*        hash);          //-- output 32bytes hash/data SHA256 value at last good checkpoint
+
+bool rsha256_shadow_finish(     //-- return true if chain verified ok up to iters_done, false if fault (roll back)
+rsha256_shadow* shadow,         //-- shadow (creation thread only)
+const uint8_t*  hash,           //-- 32bytes hash/data SHA256 value at end of creation
+const uint64_t  iters_done);    //-- number of iterations done at hash, counted as start_iters
+
+void rsha256_shadow_stats(      //-- no return value, values to output parameters
+rsha256_shadow* shadow,         //-- shadow (creation thread only)
+uint64_t*       good_iters,     //-- output number of iterations verified ok (optional, NULL)
+uint64_t*       bad_iters,      //-- output end of last failing segment, 0 = none (optional, NULL)
+uint64_t*       faults,         //-- output number of failing segments found (optional, NULL)
+uint64_t*       stalls);        //-- output number of times creator found ring full (optional, NULL)
+
+void rsha256_shadow_stop(       //-- no return value, verifier thread and engine stopped, shadow freed
+rsha256_shadow* shadow);        //-- shadow (creation thread only)
+
+#endif
+
+// <eof>
@@ -0,0 +1,250 @@
+/*
+ * File: rsha256tl_hist.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Per-chunk latency/jitter histogram of VDF creation, for TimeLord
+ * Tail distribution of chunk durations, stalls hidden by average MH/s
+ *
+ * rsha256_hist_create() - New histogram, calibrates tick counter
+ * rsha256_hist_start() - Creator, start of first chunk
+ * rsha256_hist_mark() - Creator, end of chunk, record duration
+ * rsha256_hist_func() - Creator, rsha256_cpfunc adapter for rsha256_create()
+ * rsha256_hist_percentile() - Chunk duration at percentile, seconds
+ * rsha256_hist_dump() - Print summary and non-empty buckets
+ * rsha256_hist_reset() - Clear histogram, creator not running
+ * rsha256_hist_destroy() - Free histogram
+ *
+ * Ticks from rdtsc (x64) or cntvct_el0 (ARM). Log-linear buckets, 16x
+ * sub-buckets per power of 2 (~6% precision), like HDR histogram. Single
+ * writer with relaxed atomic load/store (no locked RMW), readers any time.
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+
+#if defined(__amd64__) || defined(_M_AMD64)
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+#include "rsha256tl.h"
+
+//-- log-linear buckets, 2^HIST_SUBBITS sub-buckets per power of 2
+#define HIST_SUBBITS 4
+#define HIST_SUB     (1 << HIST_SUBBITS)
+#define HIST_BUCKETS ((64 - HIST_SUBBITS + 1) * HIST_SUB)
+
+struct rsha256_hist {
+ std::atomic<uint64_t> buckets[HIST_BUCKETS];
+ std::atomic<uint64_t> count;
+ std::atomic<uint64_t> sum;
+ std::atomic<uint64_t> min;
+ std::atomic<uint64_t> max;
+ uint64_t              last;           //-- creator, ticks at end of previous chunk
+ uint64_t              cp_iters;       //-- creator, iterations per chunk (from rsha256_hist_func)
+ uint64_t              cp_last;
+ double                tick_hz;        //-- ticks per second
+};
+
+//-- local_Ticks() - tick counter, rdtsc (x64), cntvct_el0 (ARM), steady clock ns (other)
+static inline uint64_t local_Ticks(void)
+{
+#if defined(__amd64__) || defined(_M_AMD64)
+ return __rdtsc();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+ return (uint64_t)_ReadStatusReg(ARM64_CNTVCT);
+#elif defined(__aarch64__)
+ uint64_t ticks;
+ __asm__ __volatile__("isb; mrs %0, cntvct_el0" : "=r"(ticks) :: "memory");
+ return ticks;
+#else
+ return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+//-- local_TickHz() - ticks per second, cntfrq_el0 (ARM), else calibrated against steady clock
+static double local_TickHz(void)
+{
+#if defined(__aarch64__) && !defined(_MSC_VER)
+ uint64_t freq;
+ __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(freq));
+ if(freq > 0){ return (double)freq; }
+#endif
+ const auto     time0 = std::chrono::steady_clock::now();
+ const uint64_t tick0 = local_Ticks();
+ while(std::chrono::steady_clock::now() - time0 < std::chrono::milliseconds(20)){}
+ const uint64_t tick1 = local_Ticks();
+ const double   secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - time0).count();
+ return (secs > 0.0 && tick1 > tick0) ? (double)(tick1 - tick0) / secs : 1e9;
+}
+
+//-- local_Bucket() - bucket index of value
+static inline uint32_t local_Bucket(const uint64_t value)
+{
+ if(value < HIST_SUB){ return (uint32_t)value; }
+#if defined(_MSC_VER)
+ unsigned long msb;
+ _BitScanReverse64(&msb,value);
+#else
+ const uint32_t msb = 63 - (uint32_t)__builtin_clzll(value);
+#endif
+ const uint32_t shift = (uint32_t)msb - HIST_SUBBITS;
+ return (shift + 1) * HIST_SUB + (uint32_t)((value >> shift) & (HIST_SUB - 1));
+}
+
+//-- local_BucketLow() - lowest value in bucket
+static inline uint64_t local_BucketLow(const uint32_t idx)
+{
+ if(idx < HIST_SUB){ return idx; }
+ return (uint64_t)(HIST_SUB + idx % HIST_SUB) << (idx / HIST_SUB - 1);
+}
+
+//-- local_Add() - single writer increment, no locked RMW
+static inline void local_Add(std::atomic<uint64_t>& value,const uint64_t add)
+{
+ value.store(value.load(std::memory_order_relaxed) + add,std::memory_order_relaxed);
+}
+
+//-- rsha256_hist_reset() - clear histogram, creator not running
+void rsha256_hist_reset(
+rsha256_hist* hist)
+{
+ for(uint32_t i = 0; i < HIST_BUCKETS; ++i){ hist->buckets[i].store(0,std::memory_order_relaxed); }
+ hist->count.store(0,std::memory_order_relaxed);
+ hist->sum.store(0,std::memory_order_relaxed);
+ hist->min.store(UINT64_MAX,std::memory_order_relaxed);
+ hist->max.store(0,std::memory_order_relaxed);
+ hist->last = local_Ticks();
+ hist->cp_iters = 0;
+ hist->cp_last = 0;
+}
+
+//-- rsha256_hist_create() - new histogram, calibrates tick counter
+rsha256_hist* rsha256_hist_create(void)
+{
+ rsha256_hist* hist = new rsha256_hist;
+ hist->tick_hz = local_TickHz();
+ rsha256_hist_reset(hist);
+ return hist;
+}
+
+//-- rsha256_hist_destroy() - free histogram
+void rsha256_hist_destroy(
+rsha256_hist* hist)
+{
+ delete hist;
+}
+
+//-- rsha256_hist_start() - start of first chunk (creation thread only)
+void rsha256_hist_start(
+rsha256_hist* hist)
+{
+ hist->last = local_Ticks();
+ hist->cp_last = 0;
+}
+
+//-- rsha256_hist_mark() - end of chunk, record duration since previous mark/start (creation thread only)
+void rsha256_hist_mark(
+rsha256_hist* hist)
+{
+ const uint64_t now = local_Ticks();
+ const uint64_t ticks = now - hist->last;
+ hist->last = now;
+
+ local_Add(hist->buckets[local_Bucket(ticks)],1);
+ local_Add(hist->sum,ticks);
+ if(ticks < hist->min.load(std::memory_order_relaxed)){ hist->min.store(ticks,std::memory_order_relaxed); }
+ if(ticks > hist->max.load(std::memory_order_relaxed)){ hist->max.store(ticks,std::memory_order_relaxed); }
+ hist->count.store(hist->count.load(std::memory_order_relaxed) + 1,std::memory_order_release);
+}
+
+//-- rsha256_hist_func() - rsha256_cpfunc adapter, cp_ctx = histogram, 1x chunk per checkpoint
+bool rsha256_hist_func(
+void*          cp_ctx,
+const uint64_t cp_iters_done,
+const uint8_t* cp_hash)
+{
+ (void)cp_hash;
+ rsha256_hist* hist = (rsha256_hist*)cp_ctx;
+ rsha256_hist_mark(hist);
+ if(hist->cp_iters == 0){ hist->cp_iters = cp_iters_done - hist->cp_last; }
+ hist->cp_last = cp_iters_done;
+ return true;
+}
+
+//-- rsha256_hist_percentile() - chunk duration at percentile (0.0-100.0), seconds
+double rsha256_hist_percentile(
+rsha256_hist* hist,
+const double  percentile)
+{
+ const uint64_t count = hist->count.load(std::memory_order_acquire);
+ if(count == 0){ return 0.0; }
+
+ uint64_t rank = (uint64_t)((percentile / 100.0) * (double)count + 0.5);
+ if(rank < 1){ rank = 1; }
+ if(rank >= count){ return (double)hist->max.load(std::memory_order_relaxed) / hist->tick_hz; }
+
+ uint64_t seen = 0;
+ for(uint32_t i = 0; i < HIST_BUCKETS; ++i){
+   seen += hist->buckets[i].load(std::memory_order_relaxed);
+   if(seen >= rank){
+     //-- middle of bucket, clamped to min/max seen
+     const uint64_t low = local_BucketLow(i);
+     const uint64_t high = (i + 1 < HIST_BUCKETS) ? local_BucketLow(i + 1) : UINT64_MAX;
+     uint64_t value = low + (high - low) / 2;
+     const uint64_t vmin = hist->min.load(std::memory_order_relaxed);
+     const uint64_t vmax = hist->max.load(std::memory_order_relaxed);
+     if(value < vmin){ value = vmin; }
+     if(value > vmax){ value = vmax; }
+     return (double)value / hist->tick_hz;
+     }
+   }
+
+ return (double)hist->max.load(std::memory_order_relaxed) / hist->tick_hz;
+}
+
+//-- rsha256_hist_dump() - print summary and non-empty buckets, any thread any time
+void rsha256_hist_dump(
+rsha256_hist*  hist,
+FILE*          fp,
+const uint64_t chunk_iters)
+{
+ const uint64_t count = hist->count.load(std::memory_order_acquire);
+ const uint64_t iters = (chunk_iters > 0) ? chunk_iters : hist->cp_iters;
+ const double   us = 1e6 / hist->tick_hz;
+
+ fprintf(fp,"- Chunks: %" PRIu64 " (%" PRIu64 " iterations each), tick %.3f MHz\n",count,iters,hist->tick_hz / 1e6);
+ if(count == 0){ return; }
+
+ const double mean = (double)hist->sum.load(std::memory_order_relaxed) / (double)count;
+ fprintf(fp,"- min %.2f us, mean %.2f us, max %.2f us\n",(double)hist->min.load(std::memory_order_relaxed) * us,mean * us,(double)hist->max.load(std::memory_order_relaxed) * us);
+
+ static const double percentiles[] = { 50.0, 90.0, 99.0, 99.9, 99.99, 100.0 };
+ for(double p : percentiles){
+   const double secs = rsha256_hist_percentile(hist,p);
+   if(iters > 0 && secs > 0.0){ fprintf(fp,"- p%-6g %10.2f us (%6.2f MH/s)\n",p,secs * 1e6,(double)iters / secs / 1e6); }
+   else                       { fprintf(fp,"- p%-6g %10.2f us\n",p,secs * 1e6); }
+   }
+
+ fprintf(fp,"- Buckets (from us, count):\n");
+ for(uint32_t i = 0; i < HIST_BUCKETS; ++i){
+   const uint64_t n = hist->buckets[i].load(std::memory_order_relaxed);
+   if(n > 0){ fprintf(fp,"  %12.2f %12" PRIu64 "\n",(double)local_BucketLow(i) * us,n); }
+   }
+}
+
+// <eof>
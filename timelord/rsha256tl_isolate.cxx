@@ -0,0 +1,283 @@
+/*
+ * File: rsha256tl_isolate.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Isolation of creation thread (TimeLord), call from thread before rsha256_create()
+ *
+ * rsha256_isolate() - Pin to CPU, mlockall, optional SCHED_FIFO, warm-up, noise checks
+ *
+ * Checks (Linux) chosen CPU for noise sources, and returns warnings:
+ * - isolcpus (/sys/devices/system/cpu/isolated)
+ * - nohz_full (/sys/devices/system/cpu/nohz_full)
+ * - SMT sibling online (topology/thread_siblings_list)
+ * - cpufreq governor not performance
+ * - interrupts hitting CPU during short window (/proc/interrupts)
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+#include "rsha256tl.h"
+
+//-- warm-up iterations, SHA256 code/constants into L1, branch predictors, CPU clock up
+#define ISOLATE_WARMUP_ITERS 2000000
+
+//-- window to watch interrupts on CPU
+#define ISOLATE_IRQ_WINDOW_MS 200
+
+//-- local_Warn() - append warning line to output buffer
+static void local_Warn(
+char*        warnings,
+const size_t warnings_len,
+uint32_t*    count,
+const char*  fmt,
+...)
+{
+ ++(*count);
+ if(warnings == NULL || warnings_len == 0){ return; }
+
+ const size_t used = strlen(warnings);
+ if(used + 1 >= warnings_len){ return; }
+
+ va_list args;
+ va_start(args,fmt);
+ int len = vsnprintf(&warnings[used],warnings_len - used,fmt,args);
+ va_end(args);
+ if(len < 0){ warnings[used] = 0; return; }
+
+ const size_t end = strlen(warnings);
+ if(end + 1 < warnings_len){ warnings[end] = '\n'; warnings[end + 1] = 0; }
+}
+
+#ifdef __linux__
+
+//-- local_ReadLine() - first line of small file, false if not readable
+static bool local_ReadLine(
+const char*  path,
+std::string& line)
+{
+ FILE* fp = fopen(path,"r");
+ if(fp == NULL){ return false; }
+ char buf[1024];
+ bool ok = (fgets(buf,sizeof(buf),fp) != NULL);
+ fclose(fp);
+ if(!ok){ line.clear(); return true; }
+ line = buf;
+ while(!line.empty() && (line.back() == '\n' || line.back() == '\r' || line.back() == ' ')){ line.pop_back(); }
+ return true;
+}
+
+//-- local_InCpuList() - is cpu in cpulist format, "0-3,8,10-11"
+static bool local_InCpuList(
+const std::string& list,
+const int32_t      cpu)
+{
+ const char* p = list.c_str();
+ while(*p){
+   char* end;
+   long lo = strtol(p,&end,10);
+   if(end == p){ break; }
+   long hi = lo;
+   p = end;
+   if(*p == '-'){ hi = strtol(p + 1,&end,10); p = end; }
+   if(cpu >= lo && cpu <= hi){ return true; }
+   while(*p == ',' || *p == ' '){ ++p; }
+   }
+ return false;
+}
+
+//-- local_Interrupts() - per interrupt source, count on cpu (/proc/interrupts)
+static void local_Interrupts(
+const int32_t             cpu,
+std::vector<std::string>& names,
+std::vector<uint64_t>&    counts)
+{
+ names.clear();
+ counts.clear();
+
+ FILE* fp = fopen("/proc/interrupts","r");
+ if(fp == NULL){ return; }
+
+ //-- header, column of cpu
+ char buf[8192];
+ int32_t column = -1;
+ if(fgets(buf,sizeof(buf),fp) != NULL){
+   int32_t idx = 0;
+   for(char* tok = strtok(buf," \t\n"); tok != NULL; tok = strtok(NULL," \t\n"), ++idx){
+     if(!strncmp(tok,"CPU",3) && atoi(tok + 3) == cpu){ column = idx; break; }
+     }
+   }
+
+ while(column >= 0 && fgets(buf,sizeof(buf),fp) != NULL){
+   char* p = buf;
+   while(*p == ' '){ ++p; }
+   char* colon = strchr(p,':');
+   if(colon == NULL){ continue; }
+   *colon = 0;
+   std::string name = p;
+   p = colon + 1;
+
+   uint64_t value = 0;
+   bool     found = false;
+   for(int32_t idx = 0; idx <= column; ++idx){
+     char* end;
+     unsigned long long v = strtoull(p,&end,10);
+     if(end == p){ break; }
+     p = end;
+     if(idx == column){ value = v; found = true; }
+     }
+   if(!found){ continue; }
+
+   //-- add description of source, rest of line with spaces collapsed
+   std::string desc;
+   for(; *p; ++p){
+     if(*p == ' ' || *p == '\t' || *p == '\n'){ if(!desc.empty() && desc.back() != ' '){ desc += ' '; } }
+     else{ desc += *p; }
+     }
+   while(!desc.empty() && desc.back() == ' '){ desc.pop_back(); }
+   if(!desc.empty()){ name += " (" + desc + ")"; }
+
+   names.push_back(name);
+   counts.push_back(value);
+   }
+
+ fclose(fp);
+}
+
+#endif
+
+//-- rsha256_isolate() - pin to CPU, mlockall, optional SCHED_FIFO, warm-up, noise checks
+uint32_t rsha256_isolate(
+const int32_t cpu,
+const bool    mlock,
+const int32_t fifo_prio,
+char*         warnings,
+const size_t  warnings_len)
+{
+ uint32_t count = 0;
+ if(warnings != NULL && warnings_len > 0){ warnings[0] = 0; }
+
+#ifdef __linux__
+
+ //-- pin calling thread
+ int32_t pincpu = cpu;
+ if(pincpu < 0){ pincpu = sched_getcpu(); }
+ if(pincpu >= 0 && pincpu < CPU_SETSIZE){
+   cpu_set_t set;
+   CPU_ZERO(&set);
+   CPU_SET(pincpu,&set);
+   if(pthread_setaffinity_np(pthread_self(),sizeof(set),&set) != 0){ local_Warn(warnings,warnings_len,&count,"Could not pin thread to CPU %d",pincpu); }
+   }
+ else{ local_Warn(warnings,warnings_len,&count,"CPU %d not valid, thread not pinned",pincpu); pincpu = -1; }
+
+ //-- no page faults on creation core
+ if(mlock && mlockall(MCL_CURRENT | MCL_FUTURE) != 0){ local_Warn(warnings,warnings_len,&count,"mlockall() failed, pages not locked (RLIMIT_MEMLOCK, CAP_IPC_LOCK)"); }
+
+ //-- real-time priority
+ if(fifo_prio > 0){
+   struct sched_param param;
+   memset(&param,0,sizeof(param));
+   param.sched_priority = fifo_prio;
+   if(pthread_setschedparam(pthread_self(),SCHED_FIFO,&param) != 0){ local_Warn(warnings,warnings_len,&count,"SCHED_FIFO priority %d not set (CAP_SYS_NICE, rtprio limit)",fifo_prio); }
+   }
+
+#elif defined(_WIN32)
+
+ int32_t pincpu = cpu;
+ if(pincpu < 0){ pincpu = (int32_t)GetCurrentProcessorNumber(); }
+ if(pincpu < 64){
+   if(SetThreadAffinityMask(GetCurrentThread(),(DWORD_PTR)1 << pincpu) == 0){ local_Warn(warnings,warnings_len,&count,"Could not pin thread to CPU %d",pincpu); }
+   }
+ else{ local_Warn(warnings,warnings_len,&count,"CPU %d not valid, thread not pinned",pincpu); }
+ if(mlock){ local_Warn(warnings,warnings_len,&count,"mlockall() not available on Windows, pages not locked"); }
+ if(fifo_prio > 0 && !SetThreadPriority(GetCurrentThread(),THREAD_PRIORITY_TIME_CRITICAL)){ local_Warn(warnings,warnings_len,&count,"Time critical thread priority not set"); }
+
+#else
+
+ (void)cpu; (void)mlock; (void)fifo_prio;
+ local_Warn(warnings,warnings_len,&count,"Pinning, mlockall and SCHED_FIFO not supported on this platform");
+
+#endif
+
+ //-- warm-up, SHA256 code and K64 constants into L1, CPU clock up
+ uint8_t hash[32];
+ memset(hash,0,32);
+ rsha256_create(hash,ISOLATE_WARMUP_ITERS,0,NULL,NULL,NULL);
+
+#ifdef __linux__
+
+ if(pincpu >= 0){
+   std::string line;
+   char path[256];
+
+   //-- isolcpus, scheduler keeps other tasks away
+   if(!local_ReadLine("/sys/devices/system/cpu/isolated",line) || !local_InCpuList(line,pincpu)){
+     local_Warn(warnings,warnings_len,&count,"CPU %d not in isolcpus, other tasks may be scheduled on it",pincpu);
+     }
+
+   //-- nohz_full, no scheduler tick while 1x task running
+   if(!local_ReadLine("/sys/devices/system/cpu/nohz_full",line) || !local_InCpuList(line,pincpu)){
+     local_Warn(warnings,warnings_len,&count,"CPU %d not in nohz_full, scheduler tick interrupts it",pincpu);
+     }
+
+   //-- SMT sibling shares core
+   snprintf(path,sizeof(path),"/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list",pincpu);
+   if(local_ReadLine(path,line)){
+     for(int32_t sib = 0; sib < CPU_SETSIZE; ++sib){
+       if(sib == pincpu || !local_InCpuList(line,sib)){ continue; }
+       snprintf(path,sizeof(path),"/sys/devices/system/cpu/cpu%d/online",sib);
+       std::string online;
+       if(!local_ReadLine(path,online) || online != "0"){ local_Warn(warnings,warnings_len,&count,"SMT sibling CPU %d online, shares core with CPU %d (keep idle or offline)",sib,pincpu); }
+       }
+     }
+
+   //-- frequency governor
+   snprintf(path,sizeof(path),"/sys/devices/system/cpu/cpu%d/cpufreq/scaling_governor",pincpu);
+   if(local_ReadLine(path,line) && line != "performance"){ local_Warn(warnings,warnings_len,&count,"CPU %d frequency governor is %s, not performance",pincpu,line.c_str()); }
+
+   //-- interrupts hitting CPU during short window
+   std::vector<std::string> names0, names1;
+   std::vector<uint64_t>    counts0, counts1;
+   local_Interrupts(pincpu,names0,counts0);
+   std::this_thread::sleep_for(std::chrono::milliseconds(ISOLATE_IRQ_WINDOW_MS));
+   local_Interrupts(pincpu,names1,counts1);
+   if(names0 == names1){
+     for(size_t i = 0; i < names1.size(); ++i){
+       if(counts1[i] > counts0[i]){ local_Warn(warnings,warnings_len,&count,"CPU %d got %" PRIu64 " interrupts from %s in %d ms",pincpu,counts1[i] - counts0[i],names1[i].c_str(),ISOLATE_IRQ_WINDOW_MS); }
+       }
+     }
+   }
+
+#endif
+
+ return count;
+}
+
+// <eof>
@@ -0,0 +1,193 @@
+/*
+ * File: rsha256tl_ring.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Lock-free single-producer/single-consumer ring of checkpoints, for TimeLord
+ * Creation thread pushes, consumer thread on another core drains to disk/network
+ *
+ * rsha256_cpring_create() - New ring, size rounded up to power of 2
+ * rsha256_cpring_destroy() - Free ring
+ * rsha256_cpring_push() - Producer, push checkpoint, spins if full (never drops)
+ * rsha256_cpring_func() - Producer, rsha256_cpfunc adapter for rsha256_create()
+ * rsha256_cpring_close() - Producer, no more checkpoints
+ * rsha256_cpring_pop() - Consumer, pop checkpoint, optional wait
+ * rsha256_cpring_stalls() - Number of times producer found ring full
+ *
+ * Head (producer) and tail (consumer) on own cache lines, each side with a
+ * cached copy of the other index. Producer only reads consumer line when its
+ * cached view says full. No locks, no syscalls on producer side. Waiting
+ * consumer spins, yields, then sleeps (50-1000us), idle consumer is no load.
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <thread>
+
+#if defined(__amd64__) || defined(_M_AMD64)
+#include <immintrin.h>
+#endif
+
+#include "rsha256tl.h"
+
+//-- 1x checkpoint, own cache line (producer/consumer on neighbour slots)
+struct alignas(64) local_cpslot {
+ uint64_t iters_done;
+ uint8_t  hash[32];
+};
+
+struct rsha256_cpring {
+ alignas(64) std::atomic<uint64_t> head;      //-- producer, next slot to write
+ uint64_t              tail_cache;            //-- producer, last seen tail
+ uint64_t              stalls;                //-- producer, number of times full
+ alignas(64) std::atomic<uint64_t> tail;      //-- consumer, next slot to read
+ uint64_t              head_cache;            //-- consumer, last seen head
+ alignas(64) std::atomic<bool> closed;        //-- producer done
+ uint64_t              mask;
+ local_cpslot*         slots;
+};
+
+//-- local_Pause() - spin wait hint
+static inline void local_Pause(void)
+{
+#if defined(__amd64__) || defined(_M_AMD64)
+ _mm_pause();
+#elif defined(_MSC_VER) && (defined(__aarch64__) || defined(_M_ARM64))
+ __yield();
+#elif defined(__aarch64__) || defined(_M_ARM64)
+ __asm__ __volatile__("yield");
+#else
+ std::this_thread::yield();
+#endif
+}
+
+//-- rsha256_cpring_create() - new ring, size rounded up to power of 2
+rsha256_cpring* rsha256_cpring_create(
+const uint32_t size)
+{
+ uint64_t slots = 2;
+ while(slots < size){ slots <<= 1; }
+
+ rsha256_cpring* ring = new rsha256_cpring;
+ ring->head = 0;
+ ring->tail_cache = 0;
+ ring->stalls = 0;
+ ring->tail = 0;
+ ring->head_cache = 0;
+ ring->closed = false;
+ ring->mask = slots - 1;
+ ring->slots = new local_cpslot[slots];
+
+ return ring;
+}
+
+//-- rsha256_cpring_destroy() - free ring
+void rsha256_cpring_destroy(
+rsha256_cpring* ring)
+{
+ if(ring == NULL){ return; }
+ delete[] ring->slots;
+ delete ring;
+}
+
+//-- rsha256_cpring_push() - push checkpoint, spins if full (never drops)
+void rsha256_cpring_push(
+rsha256_cpring* ring,
+const uint64_t  cp_iters_done,
+const uint8_t*  cp_hash)
+{
+ const uint64_t head = ring->head.load(std::memory_order_relaxed);
+
+ if(head - ring->tail_cache > ring->mask){
+   ring->tail_cache = ring->tail.load(std::memory_order_acquire);
+   if(head - ring->tail_cache > ring->mask){
+     ++ring->stalls;
+     do{
+       local_Pause();
+       ring->tail_cache = ring->tail.load(std::memory_order_acquire);
+       } while(head - ring->tail_cache > ring->mask);
+     }
+   }
+
+ local_cpslot* slot = &ring->slots[head & ring->mask];
+ slot->iters_done = cp_iters_done;
+ memcpy(slot->hash,cp_hash,32);
+
+ ring->head.store(head + 1,std::memory_order_release);
+}
+
+//-- rsha256_cpring_func() - rsha256_cpfunc adapter, cp_ctx = ring
+bool rsha256_cpring_func(
+void*          cp_ctx,
+const uint64_t cp_iters_done,
+const uint8_t* cp_hash)
+{
+ rsha256_cpring_push((rsha256_cpring*)cp_ctx,cp_iters_done,cp_hash);
+ return true;
+}
+
+//-- rsha256_cpring_close() - no more checkpoints, wakes waiting consumer
+void rsha256_cpring_close(
+rsha256_cpring* ring)
+{
+ ring->closed.store(true,std::memory_order_release);
+}
+
+//-- rsha256_cpring_pop() - pop checkpoint, optional wait until one or closed
+bool rsha256_cpring_pop(
+rsha256_cpring* ring,
+uint64_t*       cp_iters_done,
+uint8_t*        cp_hash,
+const bool      wait)
+{
+ const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+
+ if(tail == ring->head_cache){
+   uint32_t spins = 0;
+   uint32_t sleep_us = 50;
+   while(true){
+     ring->head_cache = ring->head.load(std::memory_order_acquire);
+     if(tail != ring->head_cache){ break; }
+     if(!wait){ return false; }
+     if(ring->closed.load(std::memory_order_acquire)){
+       ring->head_cache = ring->head.load(std::memory_order_acquire);
+       if(tail != ring->head_cache){ break; }
+       return false;
+       }
+     //-- spin, yield, then sleep growing 50-1000us (checkpoints can be seconds apart)
+     if(spins < 64)      { ++spins; local_Pause(); }
+     else if(spins < 128){ ++spins; std::this_thread::yield(); }
+     else{
+       std::this_thread::sleep_for(std::chrono::microseconds(sleep_us));
+       sleep_us = (sleep_us * 2 < 1000) ? sleep_us * 2 : 1000;
+       }
+     }
+   }
+
+ const local_cpslot* slot = &ring->slots[tail & ring->mask];
+ if(cp_iters_done != NULL){ *cp_iters_done = slot->iters_done; }
+ if(cp_hash != NULL){ memcpy(cp_hash,slot->hash,32); }
+
+ ring->tail.store(tail + 1,std::memory_order_release);
+
+ return true;
+}
+
+//-- rsha256_cpring_stalls() - number of times producer found ring full
+uint64_t rsha256_cpring_stalls(
+rsha256_cpring* ring)
+{
+ return ring->stalls;
+}
+
+// <eof>
@@ -0,0 +1,315 @@
+/*
+ * File: rsha256tl_shadow.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Shadow verification of live VDF creation (TimeLord), catch compute errors
+ * Overclocked creator, 1x silent error invalidates every later iteration
+ *
+ * rsha256_shadow_start() - New shadow, verifier thread and engine started
+ * rsha256_shadow_func() - Creator, rsha256_cpfunc adapter, false on fault
+ * rsha256_shadow_fault() - True if a segment failed verification
+ * rsha256_shadow_rollback() - Creator, last good checkpoint, continue from it
+ * rsha256_shadow_finish() - Creator, verify rest of chain, wait for all
+ * rsha256_shadow_stats() - Verified iterations, faults, creator stalls
+ * rsha256_shadow_stop() - Stop verifier thread and engine, free shadow
+ *
+ * Checkpoints go from creation thread through SPSC ring (rsha256tl_ring.cxx)
+ * to verifier thread, each finished segment submitted as 1x job to engine
+ * on other cores (rsha256pl_verify.cxx, pipelined kernels). First failing
+ * segment raises alert, creator stops at next checkpoint and rolls back to
+ * last good checkpoint. Creator side is a relaxed load and a ring push.
+ * Idle verifier sleeps (ring wait backs off), blocks on engine otherwise.
+ *
+ * Rollback bumps epoch. Results of older segments are dropped, and jobs
+ * of new epoch have higher priority (preempt stale ones at chunk boundary).
+ *
+ * Engine worker threads inherit CPU affinity of caller, call
+ * rsha256_shadow_start() before pinning creation thread (rsha256_isolate()).
+ *
+ * Requirement: rsha256tl_ring.cxx, ../pipeline_mt/rsha256pl_verify.cxx,
+ *              rsha256pl_vcache.cxx, rsha256pl_budget.cxx,
+ *              rsha256pl_fast_x64.cxx or rsha256pl_fast_arm.cxx,
+ *              rsha256pl_pair_x64.cxx or rsha256pl_pair_arm.cxx
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "rsha256tl.h"
+#include "../pipeline_mt/rsha256pl_verify.h"
+
+//-- max segments submitted to engine and not yet done, rest wait in ring
+#ifndef RSHA256TL_SHADOW_INFLIGHT
+#define RSHA256TL_SHADOW_INFLIGHT 64
+#endif
+
+//-- ring entry with this bit set is rollback marker, new start of chain
+#define SHADOW_MARK 0x8000000000000000ULL
+
+//-- 1x segment in flight, from previous checkpoint to checkpoint
+struct local_shadowseg {
+ uint8_t       start[32];
+ uint8_t       end[32];
+ uint64_t      end_iters;
+ int32_t       epoch;
+ rsha256_vseg  vseg;
+ rsha256_vjob* job;
+};
+
+struct rsha256_shadow {
+ alignas(64) std::atomic<bool>     fault;      //-- verifier sets, creator reads at checkpoints
+ uint64_t              base;                   //-- creator, iterations done at start/rollback
+ alignas(64) std::mutex            lock;       //-- good/bad/epoch, verifier per segment, creator at rollback
+ int32_t               epoch;                  //-- creator bumps at rollback
+ uint64_t              good_iters;             //-- last checkpoint verified ok
+ uint8_t               good_hash[32];          //-- hash/data at good_iters
+ uint64_t              bad_iters;              //-- end of last failing segment, 0 = none
+ std::atomic<uint64_t> faults;                 //-- number of failing segments found
+ rsha256_cpring*       ring;
+ rsha256_vengine*      engine;
+ std::thread           verifier;
+ rsha256_alertfunc     alert;
+ void*                 alert_ctx;
+};
+
+//-- local_Reap() - free done jobs of older epochs, wait for oldest if block
+static void local_Reap(
+rsha256_shadow*               shadow,
+std::deque<local_shadowseg*>& stale,
+const bool                    block)
+{
+ for(size_t i = 0; i < stale.size();){
+   if((block && i == 0) || rsha256_vengine_done(shadow->engine,stale[i]->job)){
+     rsha256_vengine_wait(shadow->engine,stale[i]->job);
+     delete stale[i];
+     stale.erase(stale.begin() + i);
+     continue;
+     }
+   ++i;
+   }
+}
+
+//-- local_Verifier() - checkpoints from ring to engine, results in chain order, until ring closed
+static void local_Verifier(
+rsha256_shadow* shadow)
+{
+ std::deque<local_shadowseg*> flight;
+ std::deque<local_shadowseg*> stale;
+ int32_t  epoch;
+ uint64_t prev_iters;
+ alignas(32) uint8_t prev_hash[32];
+ {
+ std::lock_guard<std::mutex> guard(shadow->lock);
+ epoch = shadow->epoch;
+ prev_iters = shadow->good_iters;
+ memcpy(prev_hash,shadow->good_hash,32);
+ }
+
+ uint64_t iters;
+ alignas(32) uint8_t hash[32];
+ bool     failed = false;
+
+ for(;;){
+
+   //-- new checkpoints, 1x job per segment (workers mix jobs in lanes), wait only if idle
+   //-- idle wait backs off to sleep in ring, no spinning thread next to creator (SMT sibling)
+   bool got = false;
+   bool closed = false;
+   while(flight.size() < RSHA256TL_SHADOW_INFLIGHT){
+     const bool idle = (flight.empty() && stale.empty());
+     if(!rsha256_cpring_pop(shadow->ring,&iters,hash,idle)){ closed = idle; break; }
+     got = true;
+
+     //-- rollback marker, segments in flight are stale
+     if(iters & SHADOW_MARK){
+       for(local_shadowseg* seg : flight){ stale.push_back(seg); }
+       flight.clear();
+       ++epoch;
+       prev_iters = iters & ~SHADOW_MARK;
+       memcpy(prev_hash,hash,32);
+       failed = false;
+       continue;
+       }
+
+     if(failed || iters <= prev_iters){ continue; }
+     local_shadowseg* seg = new local_shadowseg;
+     memcpy(seg->start,prev_hash,32);
+     memcpy(seg->end,hash,32);
+     seg->end_iters = iters;
+     seg->epoch = epoch;
+     seg->vseg.start = seg->start;
+     seg->vseg.end = seg->end;
+     seg->vseg.iters = iters - prev_iters;
+     seg->vseg.infusions = NULL;
+     seg->vseg.num_infusions = 0;
+     seg->vseg.start_iters = prev_iters;
+     seg->job = rsha256_vengine_submit(shadow->engine,&seg->vseg,1,epoch,0);
+     flight.push_back(seg);
+     prev_iters = iters;
+     memcpy(prev_hash,hash,32);
+     }
+   if(closed){ break; }
+
+   //-- results in chain order, block on oldest only if nothing else to do
+   while(!flight.empty() && (!got || rsha256_vengine_done(shadow->engine,flight.front()->job))){
+     local_shadowseg* seg = flight.front();
+     flight.pop_front();
+     const bool ok = (rsha256_vengine_wait(shadow->engine,seg->job) == 1);
+     got = true;
+
+     uint64_t good_iters = 0;
+     bool     alert = false;
+     {
+     std::lock_guard<std::mutex> guard(shadow->lock);
+     if(seg->epoch == shadow->epoch && !failed){
+       if(ok){
+         shadow->good_iters = seg->end_iters;
+         memcpy(shadow->good_hash,seg->end,32);
+         }
+       else{
+         failed = true;
+         alert = true;
+         good_iters = shadow->good_iters;
+         shadow->bad_iters = seg->end_iters;
+         shadow->faults.fetch_add(1,std::memory_order_relaxed);
+         shadow->fault.store(true,std::memory_order_release);
+         }
+       }
+     }
+     delete seg;
+
+     //-- after fault, rest in flight is stale, checkpoints dropped until rollback marker
+     if(alert){
+       for(local_shadowseg* s : flight){ stale.push_back(s); }
+       flight.clear();
+       if(shadow->alert != NULL){ shadow->alert(shadow->alert_ctx,good_iters,shadow->bad_iters); }
+       }
+     }
+
+   local_Reap(shadow,stale,!got);
+   }
+}
+
+//-- rsha256_shadow_start() - new shadow, verifier thread and engine started
+rsha256_shadow* rsha256_shadow_start(
+const uint8_t*    start_hash,
+const uint64_t    start_iters,
+const uint32_t    threads,
+const uint32_t    ring_size,
+rsha256_alertfunc alert,
+void*             alert_ctx)
+{
+ rsha256_shadow* shadow = new rsha256_shadow;
+ shadow->fault.store(false,std::memory_order_relaxed);
+ shadow->base = start_iters;
+ shadow->epoch = 0;
+ shadow->good_iters = start_iters;
+ memcpy(shadow->good_hash,start_hash,32);
+ shadow->bad_iters = 0;
+ shadow->faults.store(0,std::memory_order_relaxed);
+ shadow->ring = rsha256_cpring_create((ring_size > 0) ? ring_size : 4096);
+ shadow->engine = rsha256_vengine_create(threads,NULL);
+ shadow->alert = alert;
+ shadow->alert_ctx = alert_ctx;
+ shadow->verifier = std::thread(&local_Verifier,shadow);
+ return shadow;
+}
+
+//-- rsha256_shadow_func() - rsha256_cpfunc adapter, cp_ctx = shadow, false on fault (creation thread only)
+bool rsha256_shadow_func(
+void*          cp_ctx,
+const uint64_t cp_iters_done,
+const uint8_t* cp_hash)
+{
+ rsha256_shadow* shadow = (rsha256_shadow*)cp_ctx;
+ if(shadow->fault.load(std::memory_order_relaxed)){ return false; }
+ rsha256_cpring_push(shadow->ring,shadow->base + cp_iters_done,cp_hash);
+ return true;
+}
+
+//-- rsha256_shadow_fault() - true if a segment failed verification, creator not yet rolled back (any thread)
+bool rsha256_shadow_fault(
+rsha256_shadow* shadow)
+{
+ return shadow->fault.load(std::memory_order_acquire);
+}
+
+//-- rsha256_shadow_rollback() - last good checkpoint to *hash, continue chain from it (creation thread only)
+uint64_t rsha256_shadow_rollback(
+rsha256_shadow* shadow,
+uint8_t*        hash)
+{
+ uint64_t good;
+ {
+ std::lock_guard<std::mutex> guard(shadow->lock);
+ ++shadow->epoch;
+ good = shadow->good_iters;
+ memcpy(hash,shadow->good_hash,32);
+ }
+ rsha256_cpring_push(shadow->ring,good | SHADOW_MARK,hash);
+ shadow->base = good;
+ shadow->fault.store(false,std::memory_order_release);
+ return good;
+}
+
+//-- rsha256_shadow_finish() - verify rest of chain to hash at iters_done, wait for all, true if ok (creation thread only)
+bool rsha256_shadow_finish(
+rsha256_shadow* shadow,
+const uint8_t*  hash,
+const uint64_t  iters_done)
+{
+ if(!shadow->fault.load(std::memory_order_relaxed)){ rsha256_cpring_push(shadow->ring,iters_done,hash); }
+
+ for(;;){
+   if(shadow->fault.load(std::memory_order_acquire)){ return false; }
+   {
+   std::lock_guard<std::mutex> guard(shadow->lock);
+   if(shadow->good_iters >= iters_done){ return true; }
+   }
+   std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   }
+}
+
+//-- rsha256_shadow_stats() - verified iterations, faults, creator stalls (creation thread only)
+void rsha256_shadow_stats(
+rsha256_shadow* shadow,
+uint64_t*       good_iters,
+uint64_t*       bad_iters,
+uint64_t*       faults,
+uint64_t*       stalls)
+{
+ {
+ std::lock_guard<std::mutex> guard(shadow->lock);
+ if(good_iters != NULL){ *good_iters = shadow->good_iters; }
+ if(bad_iters != NULL){ *bad_iters = shadow->bad_iters; }
+ }
+ if(faults != NULL){ *faults = shadow->faults.load(std::memory_order_relaxed); }
+ if(stalls != NULL){ *stalls = rsha256_cpring_stalls(shadow->ring); }
+}
+
+//-- rsha256_shadow_stop() - stop verifier thread and engine, free shadow
+void rsha256_shadow_stop(
+rsha256_shadow* shadow)
+{
+ if(shadow == NULL){ return; }
+ rsha256_cpring_close(shadow->ring);
+ shadow->verifier.join();
+ rsha256_vengine_destroy(shadow->engine);
+ rsha256_cpring_destroy(shadow->ring);
+ delete shadow;
+}
+
+// <eof>
@@ -0,0 +1,261 @@
+/*
+ * File: rsha256tl_snap.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Crash-safe snapshots of VDF creation state, for TimeLord
+ * Resume chain from latest snapshot after restart, not from iteration zero
+ *
+ * rsha256_snap_start() - Start snapshot thread, writes state every interval_ms
+ * rsha256_snap_update() - Producer, publish latest state (seqlock, no blocking)
+ * rsha256_snap_func() - Producer, rsha256_cpfunc adapter for rsha256_create()
+ * rsha256_snap_stop() - Final snapshot written, thread stopped
+ * rsha256_snap_load() - Read and check snapshot file
+ *
+ * Creation thread only writes latest state under a seqlock. Side thread reads
+ * it, writes <path>.tmp, fdatasync, rename over <path>, then fsync of folder.
+ * File has magic, version and checksum. Torn/corrupt file is rejected.
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "rsha256tl.h"
+
+//-- snapshot file, 8 + 4 + 4 + 8 + 8 + 32 + 8 = 72 bytes, little-endian
+#define SNAP_MAGIC   "RSHA256S"
+#define SNAP_VERSION 1
+#define SNAP_SIZE    72
+
+struct rsha256_snapper {
+ //-- producer side, seqlock of latest state
+ alignas(64) std::atomic<uint32_t> seq;
+ std::atomic<uint64_t>   iters_done;
+ std::atomic<uint64_t>   cp_num;
+ std::atomic<uint64_t>   hash[4];
+ rsha256_snapshot        base;          //-- resumed from, added by rsha256_snap_func()
+ //-- snapshot thread
+ alignas(64) std::mutex  lock;
+ std::condition_variable wake;
+ bool                    stop;
+ bool                    ok;
+ uint64_t                written;       //-- iters_done of last snapshot written
+ uint64_t                interval_ms;
+ std::string             path;
+ std::thread             thread;
+};
+
+//-- local_Put64() / local_Get64() - little-endian
+static void local_Put64(uint8_t* p,const uint64_t v){ for(int i = 0; i < 8; ++i){ p[i] = (uint8_t)(v >> (8 * i)); } }
+static uint64_t local_Get64(const uint8_t* p){ uint64_t v = 0; for(int i = 7; i >= 0; --i){ v = (v << 8) | p[i]; } return v; }
+
+//-- local_Checksum() - FNV-1a 64bit of snapshot bytes
+static uint64_t local_Checksum(const uint8_t* data,const size_t len)
+{
+ uint64_t sum = 0xCBF29CE484222325;
+ for(size_t i = 0; i < len; ++i){ sum = (sum ^ data[i]) * 0x100000001B3; }
+ return sum;
+}
+
+//-- local_Read() - consistent copy of latest state (seqlock reader)
+static void local_Read(
+rsha256_snapper*  snap,
+rsha256_snapshot* state)
+{
+ while(true){
+   const uint32_t seq0 = snap->seq.load(std::memory_order_acquire);
+   if(seq0 & 1){ std::this_thread::yield(); continue; }
+   state->iters_done = snap->iters_done.load(std::memory_order_relaxed);
+   state->cp_num = snap->cp_num.load(std::memory_order_relaxed);
+   for(int i = 0; i < 4; ++i){ local_Put64(&state->hash[8 * i],snap->hash[i].load(std::memory_order_relaxed)); }
+   std::atomic_thread_fence(std::memory_order_acquire);
+   if(snap->seq.load(std::memory_order_relaxed) == seq0){ return; }
+   }
+}
+
+//-- local_Write() - durable write of snapshot, tmp file + fdatasync + rename + fsync folder
+static bool local_Write(
+const std::string&      path,
+const rsha256_snapshot* state)
+{
+ uint8_t data[SNAP_SIZE];
+ memcpy(&data[0],SNAP_MAGIC,8);
+ data[8] = SNAP_VERSION; data[9] = 0; data[10] = 0; data[11] = 0;
+ memset(&data[12],0,4);
+ local_Put64(&data[16],state->iters_done);
+ local_Put64(&data[24],state->cp_num);
+ memcpy(&data[32],state->hash,32);
+ local_Put64(&data[64],local_Checksum(data,64));
+
+ const std::string tmp = path + ".tmp";
+
+#ifdef _WIN32
+ FILE* fp = fopen(tmp.c_str(),"wb");
+ if(fp == NULL){ return false; }
+ bool ok = (fwrite(data,1,SNAP_SIZE,fp) == SNAP_SIZE) && (fflush(fp) == 0) && (_commit(_fileno(fp)) == 0);
+ if(fclose(fp) != 0){ ok = false; }
+ if(!ok){ remove(tmp.c_str()); return false; }
+ if(!MoveFileExA(tmp.c_str(),path.c_str(),MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)){ return false; }
+#else
+ int fd = open(tmp.c_str(),O_WRONLY | O_CREAT | O_TRUNC,0644);
+ if(fd < 0){ return false; }
+ bool ok = (write(fd,data,SNAP_SIZE) == SNAP_SIZE) && (fdatasync(fd) == 0);
+ if(close(fd) != 0){ ok = false; }
+ if(!ok){ unlink(tmp.c_str()); return false; }
+ if(rename(tmp.c_str(),path.c_str()) != 0){ unlink(tmp.c_str()); return false; }
+
+ //-- rename durable, fsync of folder holding file
+ const size_t slash = path.find_last_of('/');
+ const std::string dir = (slash == std::string::npos) ? "." : (slash == 0) ? "/" : path.substr(0,slash);
+ int dfd = open(dir.c_str(),O_RDONLY);
+ if(dfd >= 0){ fsync(dfd); close(dfd); }
+#endif
+
+ return true;
+}
+
+//-- local_SnapThread() - write latest state every interval_ms, if changed
+static void local_SnapThread(
+rsha256_snapper* snap)
+{
+ std::unique_lock<std::mutex> guard(snap->lock);
+
+ while(true){
+   snap->wake.wait_for(guard,std::chrono::milliseconds(snap->interval_ms),[snap](){ return snap->stop; });
+   const bool stop = snap->stop;
+
+   rsha256_snapshot state;
+   local_Read(snap,&state);
+   if(state.iters_done != snap->written){
+     guard.unlock();
+     const bool ok = local_Write(snap->path,&state);
+     guard.lock();
+     snap->ok = ok;
+     if(ok){ snap->written = state.iters_done; }
+     }
+
+   if(stop){ break; }
+   }
+}
+
+//-- rsha256_snap_start() - start snapshot thread, writes state every interval_ms
+rsha256_snapper* rsha256_snap_start(
+const char*             path,
+const uint64_t          interval_ms,
+const rsha256_snapshot* resume)
+{
+ rsha256_snapper* snap = new rsha256_snapper;
+
+ snap->seq = 0;
+ if(resume != NULL){ snap->base = *resume; }
+ else              { memset(&snap->base,0,sizeof(snap->base)); }
+ snap->iters_done = snap->base.iters_done;
+ snap->cp_num = snap->base.cp_num;
+ for(int i = 0; i < 4; ++i){ snap->hash[i] = local_Get64(&snap->base.hash[8 * i]); }
+
+ snap->stop = false;
+ snap->ok = true;
+ snap->written = snap->base.iters_done;
+ snap->interval_ms = (interval_ms > 0) ? interval_ms : 1;
+ snap->path = path;
+ snap->thread = std::thread(local_SnapThread,snap);
+
+ return snap;
+}
+
+//-- rsha256_snap_update() - publish latest state, seqlock writer (creation thread only)
+void rsha256_snap_update(
+rsha256_snapper* snap,
+const uint64_t   iters_done,
+const uint64_t   cp_num,
+const uint8_t*   hash)
+{
+ const uint32_t seq = snap->seq.load(std::memory_order_relaxed);
+ snap->seq.store(seq + 1,std::memory_order_relaxed);
+ std::atomic_thread_fence(std::memory_order_release);
+
+ snap->iters_done.store(iters_done,std::memory_order_relaxed);
+ snap->cp_num.store(cp_num,std::memory_order_relaxed);
+ for(int i = 0; i < 4; ++i){ snap->hash[i].store(local_Get64(&hash[8 * i]),std::memory_order_relaxed); }
+
+ snap->seq.store(seq + 2,std::memory_order_release);
+}
+
+//-- rsha256_snap_func() - rsha256_cpfunc adapter, cp_ctx = snapper, relative to resumed state
+bool rsha256_snap_func(
+void*          cp_ctx,
+const uint64_t cp_iters_done,
+const uint8_t* cp_hash)
+{
+ rsha256_snapper* snap = (rsha256_snapper*)cp_ctx;
+ const uint64_t cp_num = snap->cp_num.load(std::memory_order_relaxed) + 1;
+ rsha256_snap_update(snap,snap->base.iters_done + cp_iters_done,cp_num,cp_hash);
+ return true;
+}
+
+//-- rsha256_snap_stop() - write final snapshot, stop thread, free snapper
+bool rsha256_snap_stop(
+rsha256_snapper* snap)
+{
+ if(snap == NULL){ return false; }
+
+ {
+ std::lock_guard<std::mutex> guard(snap->lock);
+ snap->stop = true;
+ }
+ snap->wake.notify_all();
+ snap->thread.join();
+
+ const bool ok = snap->ok;
+ delete snap;
+
+ return ok;
+}
+
+//-- rsha256_snap_load() - read and check snapshot file
+bool rsha256_snap_load(
+const char*       path,
+rsha256_snapshot* state)
+{
+ uint8_t data[SNAP_SIZE];
+
+ FILE* fp = fopen(path,"rb");
+ if(fp == NULL){ return false; }
+ const size_t len = fread(data,1,SNAP_SIZE,fp);
+ const bool   eof = (fgetc(fp) == EOF);
+ fclose(fp);
+
+ if(len != SNAP_SIZE || !eof){ return false; }
+ if(memcmp(&data[0],SNAP_MAGIC,8) || data[8] != SNAP_VERSION){ return false; }
+ if(local_Get64(&data[64]) != local_Checksum(data,64)){ return false; }
+
+ state->iters_done = local_Get64(&data[16]);
+ state->cp_num = local_Get64(&data[24]);
+ memcpy(state->hash,&data[32],32);
+
+ return true;
+}
+
+// <eof>
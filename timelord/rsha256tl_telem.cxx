@@ -0,0 +1,234 @@
+/*
+ * File: rsha256tl_telem.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Shared-memory live telemetry of VDF creation, for TimeLord
+ * External monitors read it, no syscall or lock on creation core
+ *
+ * rsha256_telem_open() - Creator, create named shared-memory segment
+ * rsha256_telem_update() - Creator, publish iterations/checkpoint (seqlock)
+ * rsha256_telem_func() - Creator, rsha256_cpfunc adapter for rsha256_create()
+ * rsha256_telem_attach() - Monitor, attach read-only to named segment
+ * rsha256_telem_read() - Monitor, consistent sample of latest values
+ * rsha256_telem_close() - Detach, creator removes segment name
+ *
+ * Values updated at checkpoint granularity, with relaxed atomics under a
+ * seqlock. Only a clock read (vDSO) on creation side, to get MH/s and time.
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "rsha256tl.h"
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,"telemetry needs lock-free atomics in shared memory");
+
+#define TELEM_MAGIC   0x4D4C4554 //-- 'TELM'
+#define TELEM_VERSION 1
+#define TELEM_SIZE    4096
+
+//-- layout of shared-memory segment, same for creator and monitor
+struct local_telemshm {
+ std::atomic<uint32_t> magic;        //-- set last, when segment initialized
+ uint32_t              version;
+ uint32_t              pid;
+ alignas(64) std::atomic<uint32_t> seq;
+ std::atomic<uint64_t> iters_done;
+ std::atomic<uint64_t> cp_num;
+ std::atomic<uint64_t> rate_hs;      //-- SHA256 iterations per second, since last update
+ std::atomic<uint64_t> time_ns;      //-- wall clock of update, ns since epoch
+ std::atomic<uint64_t> hash[4];      //-- last checkpoint hash
+};
+
+struct rsha256_telem {
+ local_telemshm* shm;
+ bool            creator;
+ uint64_t        last_iters;         //-- creator, for rate
+ uint64_t        last_ns;            //-- creator, steady clock of last update
+#ifdef _WIN32
+ HANDLE          mapping;
+#else
+ char            name[256];
+#endif
+};
+
+//-- local_Map() - create or attach to named segment
+static rsha256_telem* local_Map(
+const char* name,
+const bool  creator)
+{
+ void* mem = NULL;
+ rsha256_telem* telem = new rsha256_telem;
+
+#ifdef _WIN32
+ if(creator){ telem->mapping = CreateFileMappingA(INVALID_HANDLE_VALUE,NULL,PAGE_READWRITE,0,TELEM_SIZE,name); }
+ else       { telem->mapping = OpenFileMappingA(FILE_MAP_READ,FALSE,name); }
+ if(telem->mapping == NULL){ delete telem; return NULL; }
+ mem = MapViewOfFile(telem->mapping,(creator) ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ,0,0,TELEM_SIZE);
+ if(mem == NULL){ CloseHandle(telem->mapping); delete telem; return NULL; }
+#else
+ if(name == NULL || name[0] != '/' || strlen(name) >= sizeof(telem->name)){ delete telem; return NULL; }
+ strcpy(telem->name,name);
+ int fd = shm_open(name,(creator) ? (O_CREAT | O_RDWR) : O_RDONLY,0644);
+ if(fd < 0){ delete telem; return NULL; }
+ if(creator && ftruncate(fd,TELEM_SIZE) != 0){ close(fd); shm_unlink(name); delete telem; return NULL; }
+ if(!creator){
+   struct stat st;
+   if(fstat(fd,&st) != 0 || st.st_size < TELEM_SIZE){ close(fd); delete telem; return NULL; }
+   }
+ mem = mmap(NULL,TELEM_SIZE,(creator) ? (PROT_READ | PROT_WRITE) : PROT_READ,MAP_SHARED,fd,0);
+ close(fd);
+ if(mem == MAP_FAILED){ if(creator){ shm_unlink(name); } delete telem; return NULL; }
+#endif
+
+ telem->shm = (local_telemshm*)mem;
+ telem->creator = creator;
+ telem->last_iters = 0;
+ telem->last_ns = 0;
+
+ return telem;
+}
+
+//-- local_SteadyNs() / local_WallNs() - clock in ns
+static uint64_t local_SteadyNs(void){ return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+static uint64_t local_WallNs(void){ return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count(); }
+
+//-- local_Get64() - little-endian
+static uint64_t local_Get64(const uint8_t* p){ uint64_t v = 0; for(int i = 7; i >= 0; --i){ v = (v << 8) | p[i]; } return v; }
+
+//-- rsha256_telem_open() - create named shared-memory segment (creator)
+rsha256_telem* rsha256_telem_open(
+const char* name)
+{
+ rsha256_telem* telem = local_Map(name,true);
+ if(telem == NULL){ return NULL; }
+
+ local_telemshm* shm = telem->shm;
+ shm->magic.store(0,std::memory_order_relaxed);
+ shm->version = TELEM_VERSION;
+#ifdef _WIN32
+ shm->pid = (uint32_t)GetCurrentProcessId();
+#else
+ shm->pid = (uint32_t)getpid();
+#endif
+ shm->seq.store(0,std::memory_order_relaxed);
+ shm->iters_done.store(0,std::memory_order_relaxed);
+ shm->cp_num.store(0,std::memory_order_relaxed);
+ shm->rate_hs.store(0,std::memory_order_relaxed);
+ shm->time_ns.store(local_WallNs(),std::memory_order_relaxed);
+ for(int i = 0; i < 4; ++i){ shm->hash[i].store(0,std::memory_order_relaxed); }
+ shm->magic.store(TELEM_MAGIC,std::memory_order_release);
+
+ telem->last_ns = local_SteadyNs();
+
+ return telem;
+}
+
+//-- rsha256_telem_update() - publish iterations/checkpoint, seqlock writer (creation thread only)
+void rsha256_telem_update(
+rsha256_telem* telem,
+const uint64_t iters_done,
+const uint64_t cp_num,
+const uint8_t* hash)
+{
+ local_telemshm* shm = telem->shm;
+
+ const uint64_t now = local_SteadyNs();
+ const uint64_t rate = (now > telem->last_ns && iters_done >= telem->last_iters) ? (uint64_t)((double)(iters_done - telem->last_iters) * 1e9 / (double)(now - telem->last_ns)) : 0;
+ telem->last_iters = iters_done;
+ telem->last_ns = now;
+
+ const uint32_t seq = shm->seq.load(std::memory_order_relaxed);
+ shm->seq.store(seq + 1,std::memory_order_relaxed);
+ std::atomic_thread_fence(std::memory_order_release);
+
+ shm->iters_done.store(iters_done,std::memory_order_relaxed);
+ shm->cp_num.store(cp_num,std::memory_order_relaxed);
+ shm->rate_hs.store(rate,std::memory_order_relaxed);
+ shm->time_ns.store(local_WallNs(),std::memory_order_relaxed);
+ if(hash != NULL){ for(int i = 0; i < 4; ++i){ shm->hash[i].store(local_Get64(&hash[8 * i]),std::memory_order_relaxed); } }
+
+ shm->seq.store(seq + 2,std::memory_order_release);
+}
+
+//-- rsha256_telem_func() - rsha256_cpfunc adapter, cp_ctx = telemetry
+bool rsha256_telem_func(
+void*          cp_ctx,
+const uint64_t cp_iters_done,
+const uint8_t* cp_hash)
+{
+ rsha256_telem* telem = (rsha256_telem*)cp_ctx;
+ rsha256_telem_update(telem,cp_iters_done,telem->shm->cp_num.load(std::memory_order_relaxed) + 1,cp_hash);
+ return true;
+}
+
+//-- rsha256_telem_attach() - attach read-only to named segment (monitor)
+rsha256_telem* rsha256_telem_attach(
+const char* name)
+{
+ return local_Map(name,false);
+}
+
+//-- rsha256_telem_read() - consistent sample of latest values, seqlock reader
+bool rsha256_telem_read(
+rsha256_telem*       telem,
+rsha256_telemsample* sample)
+{
+ const local_telemshm* shm = telem->shm;
+ if(shm->magic.load(std::memory_order_acquire) != TELEM_MAGIC || shm->version != TELEM_VERSION){ return false; }
+
+ for(uint32_t tries = 0; tries < 1000000; ++tries){
+   const uint32_t seq0 = shm->seq.load(std::memory_order_acquire);
+   if(seq0 & 1){ std::this_thread::yield(); continue; }
+   sample->pid = shm->pid;
+   sample->iters_done = shm->iters_done.load(std::memory_order_relaxed);
+   sample->cp_num = shm->cp_num.load(std::memory_order_relaxed);
+   sample->mhs = (double)shm->rate_hs.load(std::memory_order_relaxed) / 1000000.0;
+   sample->time_ns = shm->time_ns.load(std::memory_order_relaxed);
+   for(int i = 0; i < 4; ++i){
+     const uint64_t v = shm->hash[i].load(std::memory_order_relaxed);
+     for(int j = 0; j < 8; ++j){ sample->hash[8 * i + j] = (uint8_t)(v >> (8 * j)); }
+     }
+   std::atomic_thread_fence(std::memory_order_acquire);
+   if(shm->seq.load(std::memory_order_relaxed) == seq0){ return true; }
+   }
+
+ return false;
+}
+
+//-- rsha256_telem_close() - detach, creator removes segment name
+void rsha256_telem_close(
+rsha256_telem* telem)
+{
+ if(telem == NULL){ return; }
+#ifdef _WIN32
+ UnmapViewOfFile(telem->shm);
+ CloseHandle(telem->mapping);
+#else
+ munmap(telem->shm,TELEM_SIZE);
+ if(telem->creator){ shm_unlink(telem->name); }
+#endif
+ delete telem;
+}
+
+// <eof>
@@ -0,0 +1,1041 @@
+/*
+ * File: rsha256tl_x64.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * VDF creation with fast recursive SHA256, with intrinsics and Intel SHA Extensions
+ * Checkpoint emitting edition of rsha256_fast(), for TimeLord
+ *
+ * rsha256_create() - Advance chain, checkpoint every cp_iters to buffer and/or callback
+ * rsha256_create_x2() - Advance 2x independent chains in lockstep, checkpoints per chain
+ * rsha256_create_fused() - Advance chain in lane 1, verify queued segments in lane 2
+ * rsha256_fusedq_*() - Queue of verify segments and results, for rsha256_create_fused()
+ * rsha256_fused_calibrate() - Per-chain rate of x2 vs x1 kernel, on this core
+ * rsha256_create_until() - Advance chain until deadline, chunks adapt to measured rate
+ * rsha256_deadline() - Deadline, now + seconds, for rsha256_create_until()
+ * rsha256_create_infused() - Advance chain, SHA256(hash||data) at scheduled iterations
+ *
+ * Inner loop between checkpoints is identical to rsha256_fast(). Hash kept
+ * shuffled in registers, only shuffled back at checkpoints.
+ *
+ * Requirement: Intel/AMD x64 CPU, with SHA Extensions
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+
+#if defined(__amd64__) || defined(_M_AMD64)
+#include <immintrin.h>
+#endif
+
+#ifdef _WIN32
+#include <intrin.h>
+#endif
+
+#include "rsha256tl.h"
+
+#if defined(__amd64__) || defined(_M_AMD64)
+
+//-- iterations between polls of verify queue, when lane 2 idle (rsha256_create_fused())
+#ifndef RSHA256TL_FUSED_POLL
+#define RSHA256TL_FUSED_POLL 65536
+#endif
+
+//-- force inline of iteration into loop, no call overhead
+#if defined(_MSC_VER)
+#define RSHA256TL_INLINE __forceinline
+#else
+#define RSHA256TL_INLINE inline __attribute__((always_inline))
+#endif
+
+//-- array of 64x constants for SHA256 rounds
+alignas(64) static const uint32_t K64[64] = {
+  0x428A2F98,0x71374491,0xB5C0FBCF,0xE9B5DBA5,0x3956C25B,0x59F111F1,0x923F82A4,0xAB1C5ED5,
+  0xD807AA98,0x12835B01,0x243185BE,0x550C7DC3,0x72BE5D74,0x80DEB1FE,0x9BDC06A7,0xC19BF174,
+  0xE49B69C1,0xEFBE4786,0x0FC19DC6,0x240CA1CC,0x2DE92C6F,0x4A7484AA,0x5CB0A9DC,0x76F988DA,
+  0x983E5152,0xA831C66D,0xB00327C8,0xBF597FC7,0xC6E00BF3,0xD5A79147,0x06CA6351,0x14292967,
+  0x27B70A85,0x2E1B2138,0x4D2C6DFC,0x53380D13,0x650A7354,0x766A0ABB,0x81C2C92E,0x92722C85,
+  0xA2BFE8A1,0xA81A664B,0xC24B8B70,0xC76C51A3,0xD192E819,0xD6990624,0xF40E3585,0x106AA070,
+  0x19A4C116,0x1E376C08,0x2748774C,0x34B0BCB5,0x391C0CB3,0x4ED8AA4A,0x5B9CCA4F,0x682E6FF3,
+  0x748F82EE,0x78A5636F,0x84C87814,0x8CC70208,0x90BEFFFA,0xA4506CEB,0xBEF9A3F7,0xC67178F2
+  };
+
+//-- array of 64x W+K of padding block (2nd block), SHA256 padding logic (64bytes), precomputed
+alignas(64) static const uint32_t WK2[64] = {
+  0xC28A2F98,0x71374491,0xB5C0FBCF,0xE9B5DBA5,0x3956C25B,0x59F111F1,0x923F82A4,0xAB1C5ED5,
+  0xD807AA98,0x12835B01,0x243185BE,0x550C7DC3,0x72BE5D74,0x80DEB1FE,0x9BDC06A7,0xC19BF374,
+  0x649B69C1,0xF0FE4786,0x0FE1EDC6,0x240CF254,0x4FE9346F,0x6CC984BE,0x61B9411E,0x16F988FA,
+  0xF2C65152,0xA88E5A6D,0xB019FC65,0xB9D99EC7,0x9A1231C3,0xE70EEAA0,0xFDB1232B,0xC7353EB0,
+  0x3069BAD5,0xCB976D5F,0x5A0F118F,0xDC1EEEFD,0x0A35B689,0xDE0B7A04,0x58F4CA9D,0xE15D5B16,
+  0x007F3E86,0x37088980,0xA507EA32,0x6FAB9537,0x17406110,0x0D8CD6F1,0xCDAA3B6D,0xC0BBBE37,
+  0x83613BDA,0xDB48A363,0x0B02E931,0x6FD15CA7,0x521AFACA,0x31338431,0x6ED41A95,0x6D437890,
+  0xC39C91F2,0x9ECCABBD,0xB5C9A0E6,0x532FB63C,0xD2C741C6,0x07237EA3,0xA4954B68,0x4C191D76
+  };
+
+#define SHA256ROUND( \
+msgv, msgtmp0, msgtmp1, msgtmp2, msgtmp3, state0, state1, kvalue) \
+  msgv = msgtmp0; \
+  msgv = _mm_add_epi32(msgv,_mm_load_si128((__m128i*)(kvalue))); \
+  state1 = _mm_sha256rnds2_epu32(state1,state0,msgv); \
+  msgtmp1 = _mm_add_epi32(msgtmp1,_mm_alignr_epi8(msgtmp0,msgtmp3,4)); \
+  msgtmp1 = _mm_sha256msg2_epu32(msgtmp1,msgtmp0); \
+  msgv = _mm_shuffle_epi32(msgv,0x0E); \
+  state0 = _mm_sha256rnds2_epu32(state0,state1,msgv); \
+  msgtmp3 = _mm_sha256msg1_epu32(msgtmp3,msgtmp0);
+
+//-- local_Iterate() - num_iters of SHA256 on shuffled hash in registers, same as rsha256_fast() loop
+static RSHA256TL_INLINE void local_Iterate(
+__m128i&       HASH0_SAVE,
+__m128i&       HASH1_SAVE,
+const uint64_t num_iters)
+{
+
+ //-- pre-arranged/shuffled state values for SHA256 rounds, A-H logic
+ const __m128i ABEF_INIT = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ const __m128i CDGH_INIT = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+
+ //-- pre-arranged/shuffled values for 3rd/4th 16bytes of 1x block, SHA256 padding logic
+ const __m128i HPAD0_CACHE = _mm_set_epi64x(0x0000000000000000,0x0000000080000000);
+ const __m128i HPAD1_CACHE = _mm_set_epi64x(0x0000010000000000,0x0000000000000000);
+
+ //-- variables to calculate SHA256 rounds
+ __m128i STATE0;
+ __m128i STATE1;
+ __m128i MSGV;
+ __m128i MSGTMP0;
+ __m128i MSGTMP1;
+ __m128i MSGTMP2;
+ __m128i MSGTMP3;
+
+ //-- repeat SHA256 operation number of iterations
+ for(uint64_t i = 0; i < num_iters; ++i){
+
+   //-- init state value for SHA256 rounds
+   STATE0 = ABEF_INIT;
+   STATE1 = CDGH_INIT;
+
+   //-- rounds 0-3
+   MSGV = HASH0_SAVE;
+   MSGTMP0 = MSGV;
+   MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&K64[0])));
+   STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+   MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+   STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+
+   //-- rounds 4-7
+   MSGV = HASH1_SAVE;
+   MSGTMP1 = MSGV;
+   MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&K64[4])));
+   STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+   MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+   STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+   MSGTMP0 = _mm_sha256msg1_epu32(MSGTMP0,MSGTMP1);
+
+   //-- rounds 8-11
+   MSGV = HPAD0_CACHE;
+   MSGTMP2 = MSGV;
+   MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&K64[8])));
+   STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+   MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+   STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+   MSGTMP1 = _mm_sha256msg1_epu32(MSGTMP1,MSGTMP2);
+
+   //-- rounds 12-15
+   MSGV = HPAD1_CACHE;
+   MSGTMP3 = MSGV;
+   MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&K64[12])));
+   STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+   MSGTMP0 = _mm_add_epi32(MSGTMP0,_mm_alignr_epi8(MSGTMP3,MSGTMP2,4));
+   MSGTMP0 = _mm_sha256msg2_epu32(MSGTMP0,MSGTMP3);
+   MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+   STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+   MSGTMP2 = _mm_sha256msg1_epu32(MSGTMP2,MSGTMP3);
+
+   //-- rounds 16-19, 20-23, 24-27, 28-31
+   SHA256ROUND(MSGV,MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,STATE0,STATE1,&K64[16]);
+   SHA256ROUND(MSGV,MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0,STATE0,STATE1,&K64[20]);
+   SHA256ROUND(MSGV,MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1,STATE0,STATE1,&K64[24]);
+   SHA256ROUND(MSGV,MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,STATE0,STATE1,&K64[28]);
+
+   //-- rounds 32-35, 36-39, 40-43, 44-47
+   SHA256ROUND(MSGV,MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,STATE0,STATE1,&K64[32]);
+   SHA256ROUND(MSGV,MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0,STATE0,STATE1,&K64[36]);
+   SHA256ROUND(MSGV,MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1,STATE0,STATE1,&K64[40]);
+   SHA256ROUND(MSGV,MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,STATE0,STATE1,&K64[44]);
+
+   //-- rounds 48-51
+   SHA256ROUND(MSGV,MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,STATE0,STATE1,&K64[48]);
+
+   //-- rounds 52-55
+   MSGV = MSGTMP1;
+   MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&K64[52])));
+   STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+   MSGTMP2 = _mm_add_epi32(MSGTMP2,_mm_alignr_epi8(MSGTMP1,MSGTMP0,4));
+   MSGTMP2 = _mm_sha256msg2_epu32(MSGTMP2,MSGTMP1);
+   MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+   STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+
+   //-- rounds 56-59
+   MSGV = MSGTMP2;
+   MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&K64[56])));
+   STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+   MSGTMP3 = _mm_add_epi32(MSGTMP3,_mm_alignr_epi8(MSGTMP2,MSGTMP1,4));
+   MSGTMP3 = _mm_sha256msg2_epu32(MSGTMP3,MSGTMP2);
+   MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+   STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+
+   //-- rounds 60-63
+   MSGV = MSGTMP3;
+   MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&K64[60])));
+   STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+   MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+   STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+
+   //-- add init state to current state
+   STATE0 = _mm_add_epi32(STATE0,ABEF_INIT);
+   STATE1 = _mm_add_epi32(STATE1,CDGH_INIT);
+
+   //-- shuffle state, save for next iteration or final result
+   STATE0 = _mm_shuffle_epi32(STATE0,0x1B); // FEBA
+   STATE1 = _mm_shuffle_epi32(STATE1,0xB1); // DCHG
+   HASH0_SAVE = _mm_blend_epi16(STATE0,STATE1,0xF0); // DCBA
+   HASH1_SAVE = _mm_alignr_epi8(STATE1,STATE0,8);    // HGFE
+   }
+}
+
+//-- local_Iterate2() - num_iters of SHA256 on 2x independent hashes in registers, same as rsha256_fast_x2() loop
+static RSHA256TL_INLINE void local_Iterate2(
+__m128i&       HASH0_SAVE_P1,
+__m128i&       HASH1_SAVE_P1,
+__m128i&       HASH0_SAVE_P2,
+__m128i&       HASH1_SAVE_P2,
+const uint64_t num_iters)
+{
+
+ //-- pre-arranged/shuffled state values for SHA256 rounds, A-H logic
+ const __m128i ABEF_INIT = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ const __m128i CDGH_INIT = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+
+ //-- pre-arranged/shuffled values for 3rd/4th 16bytes of 1x block, SHA256 padding logic
+ const __m128i HPAD0_CACHE = _mm_set_epi64x(0x0000000000000000,0x0000000080000000);
+ const __m128i HPAD1_CACHE = _mm_set_epi64x(0x0000010000000000,0x0000000000000000);
+
+ //-- variables to calculate SHA256 rounds
+ __m128i STATE0_P1; __m128i STATE1_P1; __m128i MSGV_P1; __m128i MSGTMP0_P1; __m128i MSGTMP1_P1; __m128i MSGTMP2_P1; __m128i MSGTMP3_P1;
+ __m128i STATE0_P2; __m128i STATE1_P2; __m128i MSGV_P2; __m128i MSGTMP0_P2; __m128i MSGTMP1_P2; __m128i MSGTMP2_P2; __m128i MSGTMP3_P2;
+
+ //-- repeat SHA256 operation number of iterations
+ for(uint64_t i = 0; i < num_iters; ++i){
+
+   //-- init state value for SHA256 rounds
+   STATE0_P1 = ABEF_INIT;
+   STATE0_P2 = ABEF_INIT;
+   STATE1_P1 = CDGH_INIT;
+   STATE1_P2 = CDGH_INIT;
+
+   //-- rounds 0-3
+   MSGV_P1 = HASH0_SAVE_P1;
+   MSGV_P2 = HASH0_SAVE_P2;
+   MSGTMP0_P1 = MSGV_P1;
+   MSGTMP0_P2 = MSGV_P2;
+   MSGV_P1 = _mm_add_epi32(MSGV_P1,_mm_load_si128((__m128i*)(&K64[0])));
+   MSGV_P2 = _mm_add_epi32(MSGV_P2,_mm_load_si128((__m128i*)(&K64[0])));
+   STATE1_P1 = _mm_sha256rnds2_epu32(STATE1_P1,STATE0_P1,MSGV_P1);
+   STATE1_P2 = _mm_sha256rnds2_epu32(STATE1_P2,STATE0_P2,MSGV_P2);
+   MSGV_P1 = _mm_shuffle_epi32(MSGV_P1,0x0E);
+   MSGV_P2 = _mm_shuffle_epi32(MSGV_P2,0x0E);
+   STATE0_P1 = _mm_sha256rnds2_epu32(STATE0_P1,STATE1_P1,MSGV_P1);
+   STATE0_P2 = _mm_sha256rnds2_epu32(STATE0_P2,STATE1_P2,MSGV_P2);
+
+   //-- rounds 4-7
+   MSGV_P1 = HASH1_SAVE_P1;
+   MSGV_P2 = HASH1_SAVE_P2;
+   MSGTMP1_P1 = MSGV_P1;
+   MSGTMP1_P2 = MSGV_P2;
+   MSGV_P1 = _mm_add_epi32(MSGV_P1,_mm_load_si128((__m128i*)(&K64[4])));
+   MSGV_P2 = _mm_add_epi32(MSGV_P2,_mm_load_si128((__m128i*)(&K64[4])));
+   STATE1_P1 = _mm_sha256rnds2_epu32(STATE1_P1,STATE0_P1,MSGV_P1);
+   STATE1_P2 = _mm_sha256rnds2_epu32(STATE1_P2,STATE0_P2,MSGV_P2);
+   MSGV_P1 = _mm_shuffle_epi32(MSGV_P1,0x0E);
+   MSGV_P2 = _mm_shuffle_epi32(MSGV_P2,0x0E);
+   STATE0_P1 = _mm_sha256rnds2_epu32(STATE0_P1,STATE1_P1,MSGV_P1);
+   STATE0_P2 = _mm_sha256rnds2_epu32(STATE0_P2,STATE1_P2,MSGV_P2);
+   MSGTMP0_P1 = _mm_sha256msg1_epu32(MSGTMP0_P1,MSGTMP1_P1);
+   MSGTMP0_P2 = _mm_sha256msg1_epu32(MSGTMP0_P2,MSGTMP1_P2);
+
+   //-- rounds 8-11
+   MSGV_P1 = HPAD0_CACHE;
+   MSGV_P2 = HPAD0_CACHE;
+   MSGTMP2_P1 = MSGV_P1;
+   MSGTMP2_P2 = MSGV_P2;
+   MSGV_P1 = _mm_add_epi32(MSGV_P1,_mm_load_si128((__m128i*)(&K64[8])));
+   MSGV_P2 = _mm_add_epi32(MSGV_P2,_mm_load_si128((__m128i*)(&K64[8])));
+   STATE1_P1 = _mm_sha256rnds2_epu32(STATE1_P1,STATE0_P1,MSGV_P1);
+   STATE1_P2 = _mm_sha256rnds2_epu32(STATE1_P2,STATE0_P2,MSGV_P2);
+   MSGV_P1 = _mm_shuffle_epi32(MSGV_P1,0x0E);
+   MSGV_P2 = _mm_shuffle_epi32(MSGV_P2,0x0E);
+   STATE0_P1 = _mm_sha256rnds2_epu32(STATE0_P1,STATE1_P1,MSGV_P1);
+   STATE0_P2 = _mm_sha256rnds2_epu32(STATE0_P2,STATE1_P2,MSGV_P2);
+   MSGTMP1_P1 = _mm_sha256msg1_epu32(MSGTMP1_P1,MSGTMP2_P1);
+   MSGTMP1_P2 = _mm_sha256msg1_epu32(MSGTMP1_P2,MSGTMP2_P2);
+
+   //-- rounds 12-15
+   MSGV_P1 = HPAD1_CACHE;
+   MSGV_P2 = HPAD1_CACHE;
+   MSGTMP3_P1 = MSGV_P1;
+   MSGTMP3_P2 = MSGV_P2;
+   MSGV_P1 = _mm_add_epi32(MSGV_P1,_mm_load_si128((__m128i*)(&K64[12])));
+   MSGV_P2 = _mm_add_epi32(MSGV_P2,_mm_load_si128((__m128i*)(&K64[12])));
+   STATE1_P1 = _mm_sha256rnds2_epu32(STATE1_P1,STATE0_P1,MSGV_P1);
+   STATE1_P2 = _mm_sha256rnds2_epu32(STATE1_P2,STATE0_P2,MSGV_P2);
+   MSGTMP0_P1 = _mm_add_epi32(MSGTMP0_P1,_mm_alignr_epi8(MSGTMP3_P1,MSGTMP2_P1,4));
+   MSGTMP0_P2 = _mm_add_epi32(MSGTMP0_P2,_mm_alignr_epi8(MSGTMP3_P2,MSGTMP2_P2,4));
+   MSGTMP0_P1 = _mm_sha256msg2_epu32(MSGTMP0_P1,MSGTMP3_P1);
+   MSGTMP0_P2 = _mm_sha256msg2_epu32(MSGTMP0_P2,MSGTMP3_P2);
+   MSGV_P1 = _mm_shuffle_epi32(MSGV_P1,0x0E);
+   MSGV_P2 = _mm_shuffle_epi32(MSGV_P2,0x0E);
+   STATE0_P1 = _mm_sha256rnds2_epu32(STATE0_P1,STATE1_P1,MSGV_P1);
+   STATE0_P2 = _mm_sha256rnds2_epu32(STATE0_P2,STATE1_P2,MSGV_P2);
+   MSGTMP2_P1 = _mm_sha256msg1_epu32(MSGTMP2_P1,MSGTMP3_P1);
+   MSGTMP2_P2 = _mm_sha256msg1_epu32(MSGTMP2_P2,MSGTMP3_P2);
+
+#define SHA256ROUND_X2( \
+msgv_p1, msgtmp0_p1, msgtmp1_p1, msgtmp2_p1, msgtmp3_p1, state0_p1, state1_p1, \
+msgv_p2, msgtmp0_p2, msgtmp1_p2, msgtmp2_p2, msgtmp3_p2, state0_p2, state1_p2, kvalue) \
+  msgv_p1 = msgtmp0_p1; \
+  msgv_p2 = msgtmp0_p2; \
+  msgv_p1 = _mm_add_epi32(msgv_p1,_mm_load_si128((__m128i*)(kvalue))); \
+  msgv_p2 = _mm_add_epi32(msgv_p2,_mm_load_si128((__m128i*)(kvalue))); \
+  state1_p1 = _mm_sha256rnds2_epu32(state1_p1,state0_p1,msgv_p1); \
+  state1_p2 = _mm_sha256rnds2_epu32(state1_p2,state0_p2,msgv_p2); \
+  msgtmp1_p1 = _mm_add_epi32(msgtmp1_p1,_mm_alignr_epi8(msgtmp0_p1,msgtmp3_p1,4)); \
+  msgtmp1_p2 = _mm_add_epi32(msgtmp1_p2,_mm_alignr_epi8(msgtmp0_p2,msgtmp3_p2,4)); \
+  msgtmp1_p1 = _mm_sha256msg2_epu32(msgtmp1_p1,msgtmp0_p1); \
+  msgtmp1_p2 = _mm_sha256msg2_epu32(msgtmp1_p2,msgtmp0_p2); \
+  msgv_p1 = _mm_shuffle_epi32(msgv_p1,0x0E); \
+  msgv_p2 = _mm_shuffle_epi32(msgv_p2,0x0E); \
+  state0_p1 = _mm_sha256rnds2_epu32(state0_p1,state1_p1,msgv_p1); \
+  state0_p2 = _mm_sha256rnds2_epu32(state0_p2,state1_p2,msgv_p2); \
+  msgtmp3_p1 = _mm_sha256msg1_epu32(msgtmp3_p1,msgtmp0_p1); \
+  msgtmp3_p2 = _mm_sha256msg1_epu32(msgtmp3_p2,msgtmp0_p2);
+
+   //-- rounds 16-19, 20-23, 24-27, 28-31
+   SHA256ROUND_X2(MSGV_P1,MSGTMP0_P1,MSGTMP1_P1,MSGTMP2_P1,MSGTMP3_P1,STATE0_P1,STATE1_P1,
+                  MSGV_P2,MSGTMP0_P2,MSGTMP1_P2,MSGTMP2_P2,MSGTMP3_P2,STATE0_P2,STATE1_P2,&K64[16]);
+   SHA256ROUND_X2(MSGV_P1,MSGTMP1_P1,MSGTMP2_P1,MSGTMP3_P1,MSGTMP0_P1,STATE0_P1,STATE1_P1,
+                  MSGV_P2,MSGTMP1_P2,MSGTMP2_P2,MSGTMP3_P2,MSGTMP0_P2,STATE0_P2,STATE1_P2,&K64[20]);
+   SHA256ROUND_X2(MSGV_P1,MSGTMP2_P1,MSGTMP3_P1,MSGTMP0_P1,MSGTMP1_P1,STATE0_P1,STATE1_P1,
+                  MSGV_P2,MSGTMP2_P2,MSGTMP3_P2,MSGTMP0_P2,MSGTMP1_P2,STATE0_P2,STATE1_P2,&K64[24]);
+   SHA256ROUND_X2(MSGV_P1,MSGTMP3_P1,MSGTMP0_P1,MSGTMP1_P1,MSGTMP2_P1,STATE0_P1,STATE1_P1,
+                  MSGV_P2,MSGTMP3_P2,MSGTMP0_P2,MSGTMP1_P2,MSGTMP2_P2,STATE0_P2,STATE1_P2,&K64[28]);
+
+   //-- rounds 32-35, 36-39, 40-43, 44-47
+   SHA256ROUND_X2(MSGV_P1,MSGTMP0_P1,MSGTMP1_P1,MSGTMP2_P1,MSGTMP3_P1,STATE0_P1,STATE1_P1,
+                  MSGV_P2,MSGTMP0_P2,MSGTMP1_P2,MSGTMP2_P2,MSGTMP3_P2,STATE0_P2,STATE1_P2,&K64[32]);
+   SHA256ROUND_X2(MSGV_P1,MSGTMP1_P1,MSGTMP2_P1,MSGTMP3_P1,MSGTMP0_P1,STATE0_P1,STATE1_P1,
+                  MSGV_P2,MSGTMP1_P2,MSGTMP2_P2,MSGTMP3_P2,MSGTMP0_P2,STATE0_P2,STATE1_P2,&K64[36]);
+   SHA256ROUND_X2(MSGV_P1,MSGTMP2_P1,MSGTMP3_P1,MSGTMP0_P1,MSGTMP1_P1,STATE0_P1,STATE1_P1,
+                  MSGV_P2,MSGTMP2_P2,MSGTMP3_P2,MSGTMP0_P2,MSGTMP1_P2,STATE0_P2,STATE1_P2,&K64[40]);
+   SHA256ROUND_X2(MSGV_P1,MSGTMP3_P1,MSGTMP0_P1,MSGTMP1_P1,MSGTMP2_P1,STATE0_P1,STATE1_P1,
+                  MSGV_P2,MSGTMP3_P2,MSGTMP0_P2,MSGTMP1_P2,MSGTMP2_P2,STATE0_P2,STATE1_P2,&K64[44]);
+
+   //-- rounds 48-51
+   SHA256ROUND_X2(MSGV_P1,MSGTMP0_P1,MSGTMP1_P1,MSGTMP2_P1,MSGTMP3_P1,STATE0_P1,STATE1_P1,
+                  MSGV_P2,MSGTMP0_P2,MSGTMP1_P2,MSGTMP2_P2,MSGTMP3_P2,STATE0_P2,STATE1_P2,&K64[48]);
+
+   //-- rounds 52-55
+   MSGV_P1 = MSGTMP1_P1;
+   MSGV_P2 = MSGTMP1_P2;
+   MSGV_P1 = _mm_add_epi32(MSGV_P1,_mm_load_si128((__m128i*)(&K64[52])));
+   MSGV_P2 = _mm_add_epi32(MSGV_P2,_mm_load_si128((__m128i*)(&K64[52])));
+   STATE1_P1 = _mm_sha256rnds2_epu32(STATE1_P1,STATE0_P1,MSGV_P1);
+   STATE1_P2 = _mm_sha256rnds2_epu32(STATE1_P2,STATE0_P2,MSGV_P2);
+   MSGTMP2_P1 = _mm_add_epi32(MSGTMP2_P1,_mm_alignr_epi8(MSGTMP1_P1,MSGTMP0_P1,4));
+   MSGTMP2_P2 = _mm_add_epi32(MSGTMP2_P2,_mm_alignr_epi8(MSGTMP1_P2,MSGTMP0_P2,4));
+   MSGTMP2_P1 = _mm_sha256msg2_epu32(MSGTMP2_P1,MSGTMP1_P1);
+   MSGTMP2_P2 = _mm_sha256msg2_epu32(MSGTMP2_P2,MSGTMP1_P2);
+   MSGV_P1 = _mm_shuffle_epi32(MSGV_P1,0x0E);
+   MSGV_P2 = _mm_shuffle_epi32(MSGV_P2,0x0E);
+   STATE0_P1 = _mm_sha256rnds2_epu32(STATE0_P1,STATE1_P1,MSGV_P1);
+   STATE0_P2 = _mm_sha256rnds2_epu32(STATE0_P2,STATE1_P2,MSGV_P2);
+
+   //-- rounds 56-59
+   MSGV_P1 = MSGTMP2_P1;
+   MSGV_P2 = MSGTMP2_P2;
+   MSGV_P1 = _mm_add_epi32(MSGV_P1,_mm_load_si128((__m128i*)(&K64[56])));
+   MSGV_P2 = _mm_add_epi32(MSGV_P2,_mm_load_si128((__m128i*)(&K64[56])));
+   STATE1_P1 = _mm_sha256rnds2_epu32(STATE1_P1,STATE0_P1,MSGV_P1);
+   STATE1_P2 = _mm_sha256rnds2_epu32(STATE1_P2,STATE0_P2,MSGV_P2);
+   MSGTMP3_P1 = _mm_add_epi32(MSGTMP3_P1,_mm_alignr_epi8(MSGTMP2_P1,MSGTMP1_P1,4));
+   MSGTMP3_P2 = _mm_add_epi32(MSGTMP3_P2,_mm_alignr_epi8(MSGTMP2_P2,MSGTMP1_P2,4));
+   MSGTMP3_P1 = _mm_sha256msg2_epu32(MSGTMP3_P1,MSGTMP2_P1);
+   MSGTMP3_P2 = _mm_sha256msg2_epu32(MSGTMP3_P2,MSGTMP2_P2);
+   MSGV_P1 = _mm_shuffle_epi32(MSGV_P1,0x0E);
+   MSGV_P2 = _mm_shuffle_epi32(MSGV_P2,0x0E);
+   STATE0_P1 = _mm_sha256rnds2_epu32(STATE0_P1,STATE1_P1,MSGV_P1);
+   STATE0_P2 = _mm_sha256rnds2_epu32(STATE0_P2,STATE1_P2,MSGV_P2);
+
+   //-- rounds 60-63
+   MSGV_P1 = MSGTMP3_P1;
+   MSGV_P2 = MSGTMP3_P2;
+   MSGV_P1 = _mm_add_epi32(MSGV_P1,_mm_load_si128((__m128i*)(&K64[60])));
+   MSGV_P2 = _mm_add_epi32(MSGV_P2,_mm_load_si128((__m128i*)(&K64[60])));
+   STATE1_P1 = _mm_sha256rnds2_epu32(STATE1_P1,STATE0_P1,MSGV_P1);
+   STATE1_P2 = _mm_sha256rnds2_epu32(STATE1_P2,STATE0_P2,MSGV_P2);
+   MSGV_P1 = _mm_shuffle_epi32(MSGV_P1,0x0E);
+   MSGV_P2 = _mm_shuffle_epi32(MSGV_P2,0x0E);
+   STATE0_P1 = _mm_sha256rnds2_epu32(STATE0_P1,STATE1_P1,MSGV_P1);
+   STATE0_P2 = _mm_sha256rnds2_epu32(STATE0_P2,STATE1_P2,MSGV_P2);
+
+   //-- add init state to current state
+   STATE0_P1 = _mm_add_epi32(STATE0_P1,ABEF_INIT);
+   STATE0_P2 = _mm_add_epi32(STATE0_P2,ABEF_INIT);
+   STATE1_P1 = _mm_add_epi32(STATE1_P1,CDGH_INIT);
+   STATE1_P2 = _mm_add_epi32(STATE1_P2,CDGH_INIT);
+
+   //-- shuffle state, save for next iteration or final result
+   STATE0_P1 = _mm_shuffle_epi32(STATE0_P1,0x1B); // FEBA
+   STATE1_P1 = _mm_shuffle_epi32(STATE1_P1,0xB1); // DCHG
+   STATE0_P2 = _mm_shuffle_epi32(STATE0_P2,0x1B); // FEBA
+   STATE1_P2 = _mm_shuffle_epi32(STATE1_P2,0xB1); // DCHG
+   HASH0_SAVE_P1 = _mm_blend_epi16(STATE0_P1,STATE1_P1,0xF0); // DCBA
+   HASH1_SAVE_P1 = _mm_alignr_epi8(STATE1_P1,STATE0_P1,8);    // HGFE
+   HASH0_SAVE_P2 = _mm_blend_epi16(STATE0_P2,STATE1_P2,0xF0); // DCBA
+   HASH1_SAVE_P2 = _mm_alignr_epi8(STATE1_P2,STATE0_P2,8);    // HGFE
+   }
+}
+
+//-- local_Compress() - 64x SHA256 rounds of 1x block (4x message registers) on state, no add of state
+static RSHA256TL_INLINE void local_Compress(
+__m128i&      STATE0,
+__m128i&      STATE1,
+const __m128i MSG0,
+const __m128i MSG1,
+const __m128i MSG2,
+const __m128i MSG3)
+{
+
+ //-- variables to calculate SHA256 rounds
+ __m128i MSGV;
+ __m128i MSGTMP0;
+ __m128i MSGTMP1;
+ __m128i MSGTMP2;
+ __m128i MSGTMP3;
+
+ //-- rounds 0-3
+ MSGV = MSG0;
+ MSGTMP0 = MSGV;
+ MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&K64[0])));
+ STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+ MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+ STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+
+ //-- rounds 4-7
+ MSGV = MSG1;
+ MSGTMP1 = MSGV;
+ MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&K64[4])));
+ STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+ MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+ STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+ MSGTMP0 = _mm_sha256msg1_epu32(MSGTMP0,MSGTMP1);
+
+ //-- rounds 8-11
+ MSGV = MSG2;
+ MSGTMP2 = MSGV;
+ MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&K64[8])));
+ STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+ MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+ STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+ MSGTMP1 = _mm_sha256msg1_epu32(MSGTMP1,MSGTMP2);
+
+ //-- rounds 12-15
+ MSGV = MSG3;
+ MSGTMP3 = MSGV;
+ MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&K64[12])));
+ STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+ MSGTMP0 = _mm_add_epi32(MSGTMP0,_mm_alignr_epi8(MSGTMP3,MSGTMP2,4));
+ MSGTMP0 = _mm_sha256msg2_epu32(MSGTMP0,MSGTMP3);
+ MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+ STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+ MSGTMP2 = _mm_sha256msg1_epu32(MSGTMP2,MSGTMP3);
+
+ //-- rounds 16-19, 20-23, 24-27, 28-31
+ SHA256ROUND(MSGV,MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,STATE0,STATE1,&K64[16]);
+ SHA256ROUND(MSGV,MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0,STATE0,STATE1,&K64[20]);
+ SHA256ROUND(MSGV,MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1,STATE0,STATE1,&K64[24]);
+ SHA256ROUND(MSGV,MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,STATE0,STATE1,&K64[28]);
+
+ //-- rounds 32-35, 36-39, 40-43, 44-47
+ SHA256ROUND(MSGV,MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,STATE0,STATE1,&K64[32]);
+ SHA256ROUND(MSGV,MSGTMP1,MSGTMP2,MSGTMP3,MSGTMP0,STATE0,STATE1,&K64[36]);
+ SHA256ROUND(MSGV,MSGTMP2,MSGTMP3,MSGTMP0,MSGTMP1,STATE0,STATE1,&K64[40]);
+ SHA256ROUND(MSGV,MSGTMP3,MSGTMP0,MSGTMP1,MSGTMP2,STATE0,STATE1,&K64[44]);
+
+ //-- rounds 48-51
+ SHA256ROUND(MSGV,MSGTMP0,MSGTMP1,MSGTMP2,MSGTMP3,STATE0,STATE1,&K64[48]);
+
+ //-- rounds 52-55
+ MSGV = MSGTMP1;
+ MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&K64[52])));
+ STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+ MSGTMP2 = _mm_add_epi32(MSGTMP2,_mm_alignr_epi8(MSGTMP1,MSGTMP0,4));
+ MSGTMP2 = _mm_sha256msg2_epu32(MSGTMP2,MSGTMP1);
+ MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+ STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+
+ //-- rounds 56-59
+ MSGV = MSGTMP2;
+ MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&K64[56])));
+ STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+ MSGTMP3 = _mm_add_epi32(MSGTMP3,_mm_alignr_epi8(MSGTMP2,MSGTMP1,4));
+ MSGTMP3 = _mm_sha256msg2_epu32(MSGTMP3,MSGTMP2);
+ MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+ STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+
+ //-- rounds 60-63
+ MSGV = MSGTMP3;
+ MSGV = _mm_add_epi32(MSGV,_mm_load_si128((__m128i*)(&K64[60])));
+ STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+ MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+ STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+}
+
+//-- local_CompressPad() - 64x SHA256 rounds of padding block (2nd block of 64bytes), W+K from precomputed array, no add of state
+static RSHA256TL_INLINE void local_CompressPad(
+__m128i& STATE0,
+__m128i& STATE1)
+{
+ __m128i MSGV;
+ for(uint32_t k = 0; k < 64; k += 4){
+   MSGV = _mm_load_si128((const __m128i*)(&WK2[k]));
+   STATE1 = _mm_sha256rnds2_epu32(STATE1,STATE0,MSGV);
+   MSGV = _mm_shuffle_epi32(MSGV,0x0E);
+   STATE0 = _mm_sha256rnds2_epu32(STATE0,STATE1,MSGV);
+   }
+}
+
+//-- local_Infuse() - 1x iteration as SHA256(hash||data), 64bytes in 2x blocks, on shuffled hash in registers
+static RSHA256TL_INLINE void local_Infuse(
+__m128i&       HASH0_SAVE,
+__m128i&       HASH1_SAVE,
+const uint8_t* data)
+{
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+ const __m128i ABEF_INIT = _mm_set_epi64x(0x6A09E667BB67AE85,0x510E527F9B05688C);
+ const __m128i CDGH_INIT = _mm_set_epi64x(0x3C6EF372A54FF53A,0x1F83D9AB5BE0CD19);
+
+ //-- 1st block, hash||data
+ __m128i STATE0 = ABEF_INIT;
+ __m128i STATE1 = CDGH_INIT;
+ local_Compress(STATE0,STATE1,HASH0_SAVE,HASH1_SAVE,
+                _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(&data[0])),SHUF_MASK),
+                _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(&data[16])),SHUF_MASK));
+ STATE0 = _mm_add_epi32(STATE0,ABEF_INIT);
+ STATE1 = _mm_add_epi32(STATE1,CDGH_INIT);
+
+ //-- 2nd block, padding only, precomputed W+K
+ const __m128i SAVE0 = STATE0;
+ const __m128i SAVE1 = STATE1;
+ local_CompressPad(STATE0,STATE1);
+ STATE0 = _mm_add_epi32(STATE0,SAVE0);
+ STATE1 = _mm_add_epi32(STATE1,SAVE1);
+
+ //-- shuffle state, save for next iteration or final result
+ STATE0 = _mm_shuffle_epi32(STATE0,0x1B); // FEBA
+ STATE1 = _mm_shuffle_epi32(STATE1,0xB1); // DCHG
+ HASH0_SAVE = _mm_blend_epi16(STATE0,STATE1,0xF0); // DCBA
+ HASH1_SAVE = _mm_alignr_epi8(STATE1,STATE0,8);    // HGFE
+}
+
+//-- local_Store() - shuffle SHA Extensions hash value back, store 32bytes
+static RSHA256TL_INLINE void local_Store(
+uint8_t*      hash,
+const __m128i HASH0_SAVE,
+const __m128i HASH1_SAVE)
+{
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+ _mm_storeu_si128((__m128i*)(&hash[0]),_mm_shuffle_epi8(HASH0_SAVE,SHUF_MASK));
+ _mm_storeu_si128((__m128i*)(&hash[16]),_mm_shuffle_epi8(HASH1_SAVE,SHUF_MASK));
+}
+
+uint64_t rsha256_create(   //-- return number of iterations done, less than num_iters if stopped by cp_func
+uint8_t*       hash,       //-- input/output 32bytes hash/data SHA256 value
+const uint64_t num_iters,  //-- number of times to SHA256 32bytes given in *hash
+const uint64_t cp_iters,   //-- number of iterations between checkpoints, 0 = none
+uint8_t*       cp_hashes,  //-- output num_iters / cp_iters x 32bytes checkpoint values (optional, NULL)
+rsha256_cpfunc cp_func,    //-- called at each checkpoint, return false to stop (optional, NULL)
+void*          cp_ctx)     //-- context given to cp_func
+{
+
+ //-- shuffle mask for byte order required by SHA Extensions
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+
+ //-- variables to init/keep hash value through SHA256 rounds
+ __m128i HASH0_SAVE = _mm_loadu_si128((__m128i*)(&hash[0]));
+ __m128i HASH1_SAVE = _mm_loadu_si128((__m128i*)(&hash[16]));
+
+ //-- shuffle hash bytes required by SHA Extensions
+ HASH0_SAVE = _mm_shuffle_epi8(HASH0_SAVE,SHUF_MASK);
+ HASH1_SAVE = _mm_shuffle_epi8(HASH1_SAVE,SHUF_MASK);
+
+ //-- iterations to each checkpoint, checkpoint outside of inner loop
+ uint64_t done = 0;
+ uint64_t cp_num = 0;
+ alignas(32) uint8_t cp_hash[32];
+ while(done < num_iters){
+   uint64_t run = num_iters - done;
+   if(cp_iters > 0 && run > cp_iters) run = cp_iters;
+   local_Iterate(HASH0_SAVE,HASH1_SAVE,run);
+   done += run;
+   if(cp_iters == 0 || run != cp_iters) break;
+
+   uint8_t* cp = (cp_hashes != NULL) ? &cp_hashes[32 * cp_num] : cp_hash;
+   local_Store(cp,HASH0_SAVE,HASH1_SAVE);
+   ++cp_num;
+   if(cp_func != NULL && !cp_func(cp_ctx,done,cp)) break;
+   }
+
+ //-- copy/return final hash value into *hash
+ local_Store(hash,HASH0_SAVE,HASH1_SAVE);
+ return done;
+}
+
+uint64_t rsha256_create_x2(     //-- return number of iterations done (each chain), less than num_iters if stopped by a cp_func
+uint8_t*             hash,      //-- input/output 64 bytes, 2x 32bytes hash/data SHA256 values
+const uint64_t       num_iters, //-- number of times to SHA256 2x 32bytes given in *hash
+const uint64_t       cp_iters,  //-- number of iterations between checkpoints, 0 = none
+const rsha256_cpout* cp_out)    //-- 2x checkpoint outputs, 1x per chain (optional, NULL)
+{
+
+ //-- shuffle mask for byte order required by SHA Extensions
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+
+ //-- variables to init/keep hash value through SHA256 rounds
+ __m128i HASH0_SAVE_P1 = _mm_loadu_si128((__m128i*)(&hash[0]));
+ __m128i HASH1_SAVE_P1 = _mm_loadu_si128((__m128i*)(&hash[16]));
+ __m128i HASH0_SAVE_P2 = _mm_loadu_si128((__m128i*)(&hash[32]));
+ __m128i HASH1_SAVE_P2 = _mm_loadu_si128((__m128i*)(&hash[48]));
+
+ //-- shuffle hash bytes required by SHA Extensions
+ HASH0_SAVE_P1 = _mm_shuffle_epi8(HASH0_SAVE_P1,SHUF_MASK);
+ HASH1_SAVE_P1 = _mm_shuffle_epi8(HASH1_SAVE_P1,SHUF_MASK);
+ HASH0_SAVE_P2 = _mm_shuffle_epi8(HASH0_SAVE_P2,SHUF_MASK);
+ HASH1_SAVE_P2 = _mm_shuffle_epi8(HASH1_SAVE_P2,SHUF_MASK);
+
+ //-- chains in lockstep, iterations to each checkpoint, checkpoints per chain outside of inner loop
+ uint64_t done = 0;
+ uint64_t cp_num = 0;
+ alignas(32) uint8_t cp_hash[2][32];
+ while(done < num_iters){
+   uint64_t run = num_iters - done;
+   if(cp_iters > 0 && run > cp_iters) run = cp_iters;
+   local_Iterate2(HASH0_SAVE_P1,HASH1_SAVE_P1,HASH0_SAVE_P2,HASH1_SAVE_P2,run);
+   done += run;
+   if(cp_iters == 0 || run != cp_iters) break;
+
+   uint8_t* cp_p1 = (cp_out != NULL && cp_out[0].cp_hashes != NULL) ? &cp_out[0].cp_hashes[32 * cp_num] : cp_hash[0];
+   uint8_t* cp_p2 = (cp_out != NULL && cp_out[1].cp_hashes != NULL) ? &cp_out[1].cp_hashes[32 * cp_num] : cp_hash[1];
+   local_Store(cp_p1,HASH0_SAVE_P1,HASH1_SAVE_P1);
+   local_Store(cp_p2,HASH0_SAVE_P2,HASH1_SAVE_P2);
+   ++cp_num;
+   if(cp_out == NULL) continue;
+   bool go = true;
+   if(cp_out[0].cp_func != NULL && !cp_out[0].cp_func(cp_out[0].cp_ctx,done,cp_p1)) go = false;
+   if(cp_out[1].cp_func != NULL && !cp_out[1].cp_func(cp_out[1].cp_ctx,done,cp_p2)) go = false;
+   if(!go) break;
+   }
+
+ //-- copy/return final hash values into *hash
+ local_Store(&hash[0],HASH0_SAVE_P1,HASH1_SAVE_P1);
+ local_Store(&hash[32],HASH0_SAVE_P2,HASH1_SAVE_P2);
+ return done;
+}
+
+//-- state of rsha256_fused_calibrate() between clock reads
+static thread_local uint8_t local_calsink[64];
+
+//-- local_NowNs() - steady clock, ns
+static inline uint64_t local_NowNs(void)
+{
+ return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t rsha256_deadline(     //-- return deadline for rsha256_create_until(), steady clock ns
+const double seconds)          //-- time budget from now, seconds
+{
+ return local_NowNs() + (uint64_t)((seconds > 0.0) ? seconds * 1e9 : 0.0);
+}
+
+//-- queue of verify segments, 2x lock-free SPSC rings (segments to, results back from creation thread)
+struct local_fusedseg {
+ uint8_t  start[32];
+ uint8_t  end[32];
+ uint64_t iters;
+ uint64_t id;
+};
+
+struct local_fusedres {
+ uint64_t id;
+ int32_t  status;
+};
+
+struct rsha256_fusedq {
+ alignas(64) std::atomic<uint64_t> seg_head;  //-- submitter writes
+ alignas(64) std::atomic<uint64_t> seg_tail;  //-- creation thread writes
+ alignas(64) std::atomic<uint64_t> res_head;  //-- creation thread writes
+ alignas(64) std::atomic<uint64_t> res_tail;  //-- submitter writes
+ alignas(64) uint64_t              mask;
+ local_fusedseg*       segs;
+ local_fusedres*       results;
+};
+
+rsha256_fusedq* rsha256_fusedq_create( //-- return new queue
+const uint32_t  size)                  //-- number of segments in queue, rounded up to power of 2
+{
+ uint64_t slots = 2;
+ while(slots < size){ slots <<= 1; }
+
+ rsha256_fusedq* queue = new rsha256_fusedq;
+ queue->seg_head = 0;
+ queue->seg_tail = 0;
+ queue->res_head = 0;
+ queue->res_tail = 0;
+ queue->mask = slots - 1;
+ queue->segs = new local_fusedseg[slots];
+ queue->results = new local_fusedres[slots];
+
+ return queue;
+}
+
+void rsha256_fusedq_destroy(    //-- no return value, queue freed
+rsha256_fusedq* queue)          //-- queue to free, creation done
+{
+ if(queue == NULL){ return; }
+ delete[] queue->segs;
+ delete[] queue->results;
+ delete queue;
+}
+
+bool rsha256_fusedq_submit(     //-- return true if added, false if queue full
+rsha256_fusedq* queue,          //-- queue (submitter thread only)
+const uint8_t*  start,          //-- 32bytes hash/data SHA256 value at start of segment
+const uint8_t*  end,            //-- 32bytes hash/data SHA256 value expected at end of segment
+const uint64_t  iters,          //-- number of iterations in segment
+const uint64_t  id)             //-- id of segment, given back with result
+{
+ const uint64_t head = queue->seg_head.load(std::memory_order_relaxed);
+ if(head - queue->seg_tail.load(std::memory_order_acquire) > queue->mask){ return false; }
+
+ local_fusedseg* seg = &queue->segs[head & queue->mask];
+ memcpy(seg->start,start,32);
+ memcpy(seg->end,end,32);
+ seg->iters = iters;
+ seg->id = id;
+
+ queue->seg_head.store(head + 1,std::memory_order_release);
+ return true;
+}
+
+bool rsha256_fusedq_result(     //-- return true if result popped, false if none
+rsha256_fusedq* queue,          //-- queue (submitter thread only)
+uint64_t*       id,             //-- output id of segment (optional, NULL)
+int32_t*        status)         //-- output RSHA256_FUSED_OK/_FAIL/_ABORTED (optional, NULL)
+{
+ const uint64_t tail = queue->res_tail.load(std::memory_order_relaxed);
+ if(tail == queue->res_head.load(std::memory_order_acquire)){ return false; }
+
+ const local_fusedres* res = &queue->results[tail & queue->mask];
+ if(id != NULL){ *id = res->id; }
+ if(status != NULL){ *status = res->status; }
+
+ queue->res_tail.store(tail + 1,std::memory_order_release);
+ return true;
+}
+
+bool rsha256_fusedq_pull(       //-- return true if segment pulled, used by rsha256_create_fused()
+rsha256_fusedq* queue,          //-- queue (creation thread only)
+uint8_t*        start,          //-- output 32bytes start hash/data
+uint8_t*        end,            //-- output 32bytes expected end hash/data
+uint64_t*       iters,          //-- output number of iterations
+uint64_t*       id)             //-- output id of segment
+{
+ const uint64_t tail = queue->seg_tail.load(std::memory_order_relaxed);
+ if(tail == queue->seg_head.load(std::memory_order_acquire)){ return false; }
+
+ //-- segments pulled and not yet in result ring is at most 1x (the one in lane)
+ const uint64_t res_head = queue->res_head.load(std::memory_order_relaxed);
+ if(res_head - queue->res_tail.load(std::memory_order_acquire) > queue->mask){ return false; }
+
+ const local_fusedseg* seg = &queue->segs[tail & queue->mask];
+ memcpy(start,seg->start,32);
+ memcpy(end,seg->end,32);
+ *iters = seg->iters;
+ *id = seg->id;
+
+ queue->seg_tail.store(tail + 1,std::memory_order_release);
+ return true;
+}
+
+void rsha256_fusedq_push(       //-- no return value, result added, used by rsha256_create_fused()
+rsha256_fusedq* queue,          //-- queue (creation thread only)
+const uint64_t  id,             //-- id of segment
+const int32_t   status)         //-- RSHA256_FUSED_OK/_FAIL/_ABORTED
+{
+ const uint64_t head = queue->res_head.load(std::memory_order_relaxed);
+
+ local_fusedres* res = &queue->results[head & queue->mask];
+ res->id = id;
+ res->status = status;
+
+ queue->res_head.store(head + 1,std::memory_order_release);
+}
+
+uint64_t rsha256_create_fused(  //-- return number of iterations done, less than num_iters if stopped by cp_func
+uint8_t*        hash,           //-- input/output 32bytes hash/data SHA256 value (creation chain)
+const uint64_t  num_iters,      //-- number of times to SHA256 32bytes given in *hash
+const uint64_t  cp_iters,       //-- number of iterations between checkpoints, 0 = none
+uint8_t*        cp_hashes,      //-- output num_iters / cp_iters x 32bytes checkpoint values (optional, NULL)
+rsha256_cpfunc  cp_func,        //-- called at each checkpoint, return false to stop (optional, NULL)
+void*           cp_ctx,         //-- context given to cp_func
+rsha256_fusedq* queue)          //-- segments to verify in lane 2, results back (optional, NULL)
+{
+
+ //-- shuffle mask for byte order required by SHA Extensions
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+
+ //-- variables to init/keep hash value through SHA256 rounds, lane 1 creation, lane 2 verify
+ __m128i HASH0_SAVE_P1 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(&hash[0])),SHUF_MASK);
+ __m128i HASH1_SAVE_P1 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(&hash[16])),SHUF_MASK);
+ __m128i HASH0_SAVE_P2 = HASH0_SAVE_P1;
+ __m128i HASH1_SAVE_P2 = HASH1_SAVE_P1;
+
+ //-- lane 1 always creation chain, lane 2 verify segment if any (x2 kernel), else x1 kernel
+ //-- queue polled at chunk boundaries, at most every RSHA256TL_FUSED_POLL iterations
+ uint64_t done = 0;
+ uint64_t cp_next = cp_iters;
+ uint64_t cp_num = 0;
+ alignas(32) uint8_t cp_hash[32];
+ bool     vactive = false;
+ uint64_t vleft = 0;
+ uint64_t vid = 0;
+ alignas(32) uint8_t vstart[32];
+ alignas(32) uint8_t vend[32];
+ while(done < num_iters){
+   if(!vactive && queue != NULL && rsha256_fusedq_pull(queue,vstart,vend,&vleft,&vid)){
+     if(vleft == 0){ rsha256_fusedq_push(queue,vid,(memcmp(vstart,vend,32)) ? RSHA256_FUSED_FAIL : RSHA256_FUSED_OK); continue; }
+     HASH0_SAVE_P2 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(&vstart[0])),SHUF_MASK);
+     HASH1_SAVE_P2 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(&vstart[16])),SHUF_MASK);
+     vactive = true;
+     }
+
+   uint64_t run = num_iters - done;
+   if(cp_iters > 0 && run > cp_next - done) run = cp_next - done;
+   if(vactive){
+     if(run > vleft) run = vleft;
+     local_Iterate2(HASH0_SAVE_P1,HASH1_SAVE_P1,HASH0_SAVE_P2,HASH1_SAVE_P2,run);
+     vleft -= run;
+     if(vleft == 0){
+       alignas(32) uint8_t vhash[32];
+       local_Store(vhash,HASH0_SAVE_P2,HASH1_SAVE_P2);
+       rsha256_fusedq_push(queue,vid,(memcmp(vhash,vend,32)) ? RSHA256_FUSED_FAIL : RSHA256_FUSED_OK);
+       vactive = false;
+       }
+     }
+   else{
+     if(queue != NULL && run > RSHA256TL_FUSED_POLL) run = RSHA256TL_FUSED_POLL;
+     local_Iterate(HASH0_SAVE_P1,HASH1_SAVE_P1,run);
+     }
+   done += run;
+
+   if(cp_iters > 0 && done == cp_next){
+     cp_next += cp_iters;
+     uint8_t* cp = (cp_hashes != NULL) ? &cp_hashes[32 * cp_num] : cp_hash;
+     local_Store(cp,HASH0_SAVE_P1,HASH1_SAVE_P1);
+     ++cp_num;
+     if(cp_func != NULL && !cp_func(cp_ctx,done,cp)) break;
+     }
+   }
+
+ //-- segment in lane 2 not finished, caller may submit again
+ if(vactive){ rsha256_fusedq_push(queue,vid,RSHA256_FUSED_ABORTED); }
+
+ //-- copy/return final hash value into *hash
+ local_Store(hash,HASH0_SAVE_P1,HASH1_SAVE_P1);
+ return done;
+}
+
+double rsha256_fused_calibrate( //-- return per-chain rate of x2 kernel vs x1 kernel, 1.0 = creation lane keeps full speed
+const uint64_t num_iters)       //-- number of iterations per measurement, 0 = 1M
+{
+ const uint64_t iters = (num_iters > 0) ? num_iters : 1000000;
+ //-- shuffle mask for byte order required by SHA Extensions
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+
+ //-- state through memory between clock reads, work not moved across them by compiler
+ memset(local_calsink,0,32);
+ memset(&local_calsink[32],1,32);
+
+ //-- best of 3x each, alternating
+ uint64_t best_x1 = UINT64_MAX;
+ uint64_t best_x2 = UINT64_MAX;
+ for(int i = 0; i < 3; ++i){
+   const uint64_t time0 = local_NowNs();
+   __m128i HASH0_SAVE_P1 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(&local_calsink[0])),SHUF_MASK);
+   __m128i HASH1_SAVE_P1 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(&local_calsink[16])),SHUF_MASK);
+   local_Iterate(HASH0_SAVE_P1,HASH1_SAVE_P1,iters);
+   local_Store(&local_calsink[0],HASH0_SAVE_P1,HASH1_SAVE_P1);
+   const uint64_t time1 = local_NowNs();
+   HASH0_SAVE_P1 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(&local_calsink[0])),SHUF_MASK);
+   HASH1_SAVE_P1 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(&local_calsink[16])),SHUF_MASK);
+   __m128i HASH0_SAVE_P2 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(&local_calsink[32])),SHUF_MASK);
+   __m128i HASH1_SAVE_P2 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(&local_calsink[48])),SHUF_MASK);
+   local_Iterate2(HASH0_SAVE_P1,HASH1_SAVE_P1,HASH0_SAVE_P2,HASH1_SAVE_P2,iters);
+   local_Store(&local_calsink[0],HASH0_SAVE_P1,HASH1_SAVE_P1);
+   local_Store(&local_calsink[32],HASH0_SAVE_P2,HASH1_SAVE_P2);
+   const uint64_t time2 = local_NowNs();
+   if(time1 - time0 < best_x1) best_x1 = time1 - time0;
+   if(time2 - time1 < best_x2) best_x2 = time2 - time1;
+   }
+
+ return (best_x2 > 0) ? (double)best_x1 / (double)best_x2 : 0.0;
+}
+
+uint64_t rsha256_create_until( //-- return number of iterations done, at deadline or stopped by cp_func
+uint8_t*       hash,           //-- input/output 32bytes hash/data SHA256 value
+const uint64_t deadline_ns,    //-- deadline, steady clock ns (rsha256_deadline())
+const uint64_t overshoot_us,   //-- max time past deadline, microseconds
+const uint64_t cp_iters,       //-- number of iterations between checkpoints, 0 = none
+rsha256_cpfunc cp_func,        //-- called at each checkpoint, return false to stop (optional, NULL)
+void*          cp_ctx)         //-- context given to cp_func
+{
+
+ //-- shuffle mask for byte order required by SHA Extensions
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+
+ //-- variables to init/keep hash value through SHA256 rounds
+ __m128i HASH0_SAVE = _mm_loadu_si128((__m128i*)(&hash[0]));
+ __m128i HASH1_SAVE = _mm_loadu_si128((__m128i*)(&hash[16]));
+
+ //-- shuffle hash bytes required by SHA Extensions
+ HASH0_SAVE = _mm_shuffle_epi8(HASH0_SAVE,SHUF_MASK);
+ HASH1_SAVE = _mm_shuffle_epi8(HASH1_SAVE,SHUF_MASK);
+
+ //-- chunks adapt to measured rate, half of remaining time until within 2x overshoot,
+ //-- then remaining time, never shorter than 1/8 overshoot. Clock read only between chunks.
+ const double overshoot_ns = (double)((overshoot_us > 0) ? overshoot_us : 1) * 1000.0;
+ uint64_t done = 0;
+ uint64_t cp_next = cp_iters;
+ alignas(32) uint8_t cp_hash[32];
+ double   rate = 0.0;  //-- iterations per ns, 0.0 = not measured yet
+ uint64_t run = 256;   //-- first chunks, doubled until long enough to measure rate
+ uint64_t now = local_NowNs();
+ while(now < deadline_ns){
+   if(rate > 0.0){
+     const double remaining_ns = (double)(deadline_ns - now);
+     double chunk_ns = (remaining_ns > 2.0 * overshoot_ns) ? remaining_ns / 2.0 : remaining_ns;
+     if(chunk_ns < overshoot_ns / 8.0){ chunk_ns = overshoot_ns / 8.0; }
+     run = (uint64_t)(rate * chunk_ns);
+     if(run < 1){ run = 1; }
+     }
+   if(cp_iters > 0 && run > cp_next - done){ run = cp_next - done; }
+
+   local_Iterate(HASH0_SAVE,HASH1_SAVE,run);
+   done += run;
+
+   const uint64_t then = now;
+   now = local_NowNs();
+   if(now - then >= 10000){
+     const double measured = (double)run / (double)(now - then);
+     rate = (rate > 0.0) ? (rate + measured) / 2.0 : measured;
+     }
+   else if(rate == 0.0){ run *= 2; }
+
+   if(cp_iters > 0 && done == cp_next){
+     cp_next += cp_iters;
+     local_Store(cp_hash,HASH0_SAVE,HASH1_SAVE);
+     if(cp_func != NULL && !cp_func(cp_ctx,done,cp_hash)) break;
+     now = local_NowNs();
+     }
+   }
+
+ //-- copy/return final hash value into *hash
+ local_Store(hash,HASH0_SAVE,HASH1_SAVE);
+ return done;
+}
+
+uint64_t rsha256_create_infused(  //-- return number of iterations done, less than num_iters if stopped by cp_func, 0 if schedule not ascending
+uint8_t*                hash,           //-- input/output 32bytes hash/data SHA256 value
+const uint64_t          num_iters,      //-- number of times to SHA256 given in *hash (infusions included)
+const uint64_t          cp_iters,       //-- number of iterations between checkpoints, 0 = none
+uint8_t*                cp_hashes,      //-- output num_iters / cp_iters x 32bytes checkpoint values (optional, NULL)
+rsha256_cpfunc          cp_func,        //-- called at each checkpoint, return false to stop (optional, NULL)
+void*                   cp_ctx,         //-- context given to cp_func
+const uint64_t          start_iters,    //-- iteration of chain at *hash, infusion schedule counted from chain start
+const rsha256_infusion* infusions,      //-- infusion schedule, ascending by iteration, 1x per iteration (optional, NULL)
+const uint32_t          num_infusions)  //-- number of infusions in *infusions
+{
+
+ //-- infusion schedule strictly ascending, else nothing done (*hash unchanged)
+ for(uint32_t i = 1; i < num_infusions; ++i){
+   if(infusions[i].iter <= infusions[i - 1].iter) return 0;
+   }
+
+ //-- shuffle mask for byte order required by SHA Extensions
+ const __m128i SHUF_MASK = _mm_set_epi64x(0x0C0D0E0F08090A0B,0x0405060700010203);
+
+ //-- variables to init/keep hash value through SHA256 rounds
+ __m128i HASH0_SAVE = _mm_loadu_si128((__m128i*)(&hash[0]));
+ __m128i HASH1_SAVE = _mm_loadu_si128((__m128i*)(&hash[16]));
+
+ //-- shuffle hash bytes required by SHA Extensions
+ HASH0_SAVE = _mm_shuffle_epi8(HASH0_SAVE,SHUF_MASK);
+ HASH1_SAVE = _mm_shuffle_epi8(HASH1_SAVE,SHUF_MASK);
+
+ //-- first infusion after start of chain
+ uint32_t inf = 0;
+ while(inf < num_infusions && infusions[inf].iter <= start_iters){ ++inf; }
+
+ //-- plain iterations to next checkpoint or infusion, 2x block step at infusion, checkpoint outside of inner loop
+ uint64_t done = 0;
+ uint64_t cp_next = cp_iters;
+ uint64_t cp_num = 0;
+ alignas(32) uint8_t cp_hash[32];
+ while(done < num_iters){
+   uint64_t run = num_iters - done;
+   if(cp_iters > 0 && run > cp_next - done) run = cp_next - done;
+   if(inf < num_infusions && infusions[inf].iter - start_iters <= done + run){
+     local_Iterate(HASH0_SAVE,HASH1_SAVE,infusions[inf].iter - start_iters - 1 - done);
+     local_Infuse(HASH0_SAVE,HASH1_SAVE,infusions[inf].data);
+     done = infusions[inf].iter - start_iters;
+     ++inf;
+     }
+   else{
+     local_Iterate(HASH0_SAVE,HASH1_SAVE,run);
+     done += run;
+     }
+   if(cp_iters == 0 || done != cp_next) continue;
+
+   cp_next += cp_iters;
+   uint8_t* cp = (cp_hashes != NULL) ? &cp_hashes[32 * cp_num] : cp_hash;
+   local_Store(cp,HASH0_SAVE,HASH1_SAVE);
+   ++cp_num;
+   if(cp_func != NULL && !cp_func(cp_ctx,done,cp)) break;
+   }
+
+ //-- copy/return final hash value into *hash
+ local_Store(hash,HASH0_SAVE,HASH1_SAVE);
+ return done;
+}
+
+#endif
+
+// <eof>
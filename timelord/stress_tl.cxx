@@ -0,0 +1,409 @@
+/*
+ * File: stress_tl.cxx
+ *
+ * Author: voidxno
+ * Created: 17 Oct 2026
+ * Source: https://github.com/voidxno/fast-recursive-sha256
+ *
+ * Stress test of overclock stability (TimeLord), with fast recursive SHA256
+ * Known-answer checking on all logical CPUs, same instruction mix as creation
+ * Answers computed by reference path (rsha256_ref()), twice on different CPUs
+ *
+ * Program call: stress_tl -w <width> -i <iters> -d <minutes> -r <seconds> -t <threads> -x <cpu>
+ *
+ * -w <width>: Kernel to stress (optional)
+ *             Valid values: fast (default, rsha256_fast()), x1, x2, x3, x4 (rsha256_fast_xN())
+ *
+ * -i <iters>: Number of SHA256 iterations per check (optional)
+ *             Default 10M, K/M/G suffix (1000)
+ *
+ * -d <minutes>: Duration of stress test (optional)
+ *               Default 60, 0 = until Ctrl-C
+ *
+ * -r <seconds>: Seconds between progress reports (optional)
+ *               Default 10
+ *
+ * -t <threads>: Number of threads, 1x per logical CPU, pinned (optional)
+ *               Default 0 (all logical CPUs of process), 256 (max)
+ *
+ * -x <cpu>: Simulate error on first check of thread pinned to <cpu> (optional)
+ *           Test of error reporting, not of CPU
+ *
+ * Requirement: Intel/AMD x64 CPU, with SHA Extensions, or
+ *              ARM CPU, with Cryptography Extensions
+ *
+ * LICENSE: Unlicense
+ * For more information, please refer to <https://unlicense.org>
+ *
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#define strcasecmp _stricmp
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+//-- external functions, fast/reference recursive SHA256 (../rsha256_*.cxx)
+void rsha256_fast(uint8_t* hash, const uint64_t num_iters);
+void rsha256_ref(uint8_t* hash, const uint64_t num_iters);
+
+//-- external functions, pipelined recursive SHA256 (../pipeline_mt/rsha256pl_fast_*.cxx)
+void rsha256_fast_x1(uint8_t* hash, const uint64_t num_iters);
+void rsha256_fast_x2(uint8_t* hash, const uint64_t num_iters);
+void rsha256_fast_x3(uint8_t* hash, const uint64_t num_iters);
+void rsha256_fast_x4(uint8_t* hash, const uint64_t num_iters);
+
+//-- number of known answers, start hash/data differs in last byte
+#define STRESS_ANSWERS 16
+
+//-- per thread results, 1x writer (own thread), own cache line
+struct alignas(64) local_stressstat {
+ std::atomic<uint64_t> checks;
+ std::atomic<uint64_t> errors;
+ std::atomic<uint64_t> iters;
+ std::atomic<uint64_t> busy_ns;
+ std::atomic<uint64_t> first_ns;     //-- time to first error from start, 0 = none
+};
+
+//-- local functions
+void local_ANSISetup(void);
+void local_ANSIRestore(void);
+void local_ParseParameters(int argc,char* argv[]);
+uint64_t local_ParseIters(const char* str);
+uint64_t local_NowNs(void);
+bool local_Pin(const int32_t cpu);
+void local_CpuList(std::vector<int32_t>& cpus);
+void local_Answers(void);
+void local_Worker(const uint32_t idx);
+void local_Report(const uint64_t elapsed_ns);
+void local_Signal(int sig);
+
+//-- kernels, index by width (0 = rsha256_fast(), 1-4 = rsha256_fast_xN())
+static void (* const local_kernels[5])(uint8_t*,const uint64_t) = {
+ &rsha256_fast, &rsha256_fast_x1, &rsha256_fast_x2, &rsha256_fast_x3, &rsha256_fast_x4 };
+static const char* const local_kernelnames[5] = { "fast", "x1", "x2", "x3", "x4" };
+
+//-- local parameter values
+uint32_t local_width;
+uint64_t local_iters;
+uint64_t local_minutes;
+uint64_t local_reportsec;
+uint32_t local_threads;
+int32_t  local_faultcpu;
+
+//-- local state
+std::vector<int32_t>          local_cpus;
+std::vector<local_stressstat> local_stats;
+alignas(32) uint8_t           local_starts[STRESS_ANSWERS][32];
+alignas(32) uint8_t           local_answers[STRESS_ANSWERS][32];
+uint64_t                      local_startns;
+std::atomic<bool>             local_stop;
+
+//-- main() - entrypoint
+int main(int argc, char* argv[])
+{
+
+ //-- setup/init ANSI capability
+ local_ANSISetup();
+
+ //-- default parameter values, -w fast, -i 10M, -d 60, -r 10, -t 0, -x <not set>
+ local_width = 0;
+ local_iters = 10000000;
+ local_minutes = 60;
+ local_reportsec = 10;
+ local_threads = 0;
+ local_faultcpu = -1;
+
+ //-- display header
+ setvbuf(stdout,NULL,_IONBF,0);
+#if defined(__amd64__) || defined(_M_AMD64)
+ printf("\33[1;97m[Stress (tl) - Overclock stability, Fast Recursive SHA256 (w/Intel SHA Extensions)]\33[0m\n");
+#elif defined(__aarch64__) || defined(_M_ARM64)
+ printf("\33[1;97m[Stress (tl) - Overclock stability, Fast Recursive SHA256 (w/ARM Cryptography Extensions)]\33[0m\n");
+#else
+ printf("\33[1;97m[Stress (tl) - Overclock stability, Fast Recursive SHA256 (w/<unknown platform>)]\33[0m\n");
+#endif
+
+ //-- parse parameters
+ local_ParseParameters(argc,argv);
+
+ //-- logical CPUs, 1x thread pinned on each
+ local_CpuList(local_cpus);
+ if(local_threads > 0 && local_threads < local_cpus.size()){ local_cpus.resize(local_threads); }
+ local_stats = std::vector<local_stressstat>(local_cpus.size());
+
+ if(local_minutes > 0){ printf("- Parameters: %s (kernel), %" PRIu64 " MH (per check), %" PRIu64 " min (duration), %u (threads)\n",local_kernelnames[local_width],local_iters / 1000000,local_minutes,(uint32_t)local_cpus.size()); }
+ else                 { printf("- Parameters: %s (kernel), %" PRIu64 " MH (per check), until Ctrl-C (duration), %u (threads)\n",local_kernelnames[local_width],local_iters / 1000000,(uint32_t)local_cpus.size()); }
+
+ //-- known answers by reference path, twice on different CPUs
+ printf("- Known answers: %d x %" PRIu64 " MH by reference path ...",STRESS_ANSWERS,local_iters / 1000000);
+ local_Answers();
+ if(local_stop.load()){ fprintf(stderr,"\n\33[1;31mERROR: Reference path gave different answers on 2x CPUs, not stable !\33[0m\n"); local_ANSIRestore(); return 1; }
+ printf("\33[2K\r- Known answers: %d x %" PRIu64 " MH by reference path, \33[1;32mok\33[0m\n",STRESS_ANSWERS,local_iters / 1000000);
+
+ //-- stress, until duration or Ctrl-C
+ signal(SIGINT,&local_Signal);
+ local_startns = local_NowNs();
+ std::vector<std::thread> workers;
+ for(uint32_t i = 0; i < local_cpus.size(); ++i){ workers.push_back(std::thread(&local_Worker,i)); }
+
+ uint64_t next = local_reportsec * 1000000000ULL;
+ while(!local_stop.load()){
+   std::this_thread::sleep_for(std::chrono::milliseconds(100));
+   const uint64_t elapsed = local_NowNs() - local_startns;
+   if(local_minutes > 0 && elapsed >= local_minutes * 60000000000ULL){ local_stop.store(true); break; }
+   if(elapsed >= next){ local_Report(elapsed); next += local_reportsec * 1000000000ULL; }
+   }
+
+ for(std::thread& worker : workers){ worker.join(); }
+ const uint64_t elapsed = local_NowNs() - local_startns;
+
+ //-- per CPU results
+ uint64_t errors = 0;
+ printf("- Results after %.1f min:\n",(double)elapsed / 60e9);
+ for(uint32_t i = 0; i < local_cpus.size(); ++i){
+   const local_stressstat* st = &local_stats[i];
+   const uint64_t busy = st->busy_ns.load();
+   const double   mhs = (busy > 0) ? (double)st->iters.load() * 1000.0 / (double)busy : 0.0;
+   const uint64_t first = st->first_ns.load();
+   errors += st->errors.load();
+   if(st->errors.load() == 0){ printf("- CPU %3d: \33[1;32m%7.2f\33[0m MH/s, %8" PRIu64 " checks, \33[1;32m0\33[0m errors\n",local_cpus[i],mhs,st->checks.load()); }
+   else                      { printf("- CPU %3d: \33[1;32m%7.2f\33[0m MH/s, %8" PRIu64 " checks, \33[1;31m%" PRIu64 "\33[0m errors, first after %.1f s\n",local_cpus[i],mhs,st->checks.load(),st->errors.load(),(double)first / 1e9); }
+   }
+ if(errors > 0){ fprintf(stderr,"\33[1;31mERROR: %" PRIu64 " check(s) did not match known answer, overclock not stable !\33[0m\n",errors); }
+
+ //-- restore ANSI capability
+ local_ANSIRestore();
+
+ return (errors > 0) ? 1 : 0;
+}
+
+//-- local_ParseParameters() - parse parameters
+void local_ParseParameters(int argc,char* argv[])
+{
+ for(int i = 1, jP = 0; i < argc; ++i){
+   if((char)jP == 'w'){
+     for(uint32_t w = 0; w < 5; ++w){ if(!strcasecmp(argv[i],local_kernelnames[w])){ local_width = w; } }
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 'i'){
+     local_iters = local_ParseIters(argv[i]);
+     if(local_iters < 1){ local_iters = 10000000; }
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 'd'){
+     local_minutes = strtoull(argv[i],NULL,10);
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 'r'){
+     local_reportsec = strtoull(argv[i],NULL,10);
+     if(local_reportsec < 1){ local_reportsec = 1; }
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 't'){
+     local_threads = atoi(argv[i]);
+     if(local_threads > 256){ local_threads = 0; }
+     jP = 0; continue;
+     }
+
+   else if((char)jP == 'x'){
+     local_faultcpu = atoi(argv[i]);
+     jP = 0; continue;
+     }
+
+   jP = 0;
+   if(!strcmp(argv[i],"-w")){ jP = 'w'; continue; }
+   if(!strcmp(argv[i],"-i")){ jP = 'i'; continue; }
+   if(!strcmp(argv[i],"-d")){ jP = 'd'; continue; }
+   if(!strcmp(argv[i],"-r")){ jP = 'r'; continue; }
+   if(!strcmp(argv[i],"-t")){ jP = 't'; continue; }
+   if(!strcmp(argv[i],"-x")){ jP = 'x'; continue; }
+   }
+}
+
+//-- local_ParseIters() - number, with optional K/M/G suffix (1000)
+uint64_t local_ParseIters(const char* str)
+{
+ char* tail;
+ uint64_t val = strtoull(str,&tail,10);
+ if     (*tail == 'K' || *tail == 'k'){ val *= 1000; }
+ else if(*tail == 'M' || *tail == 'm'){ val *= 1000000; }
+ else if(*tail == 'G' || *tail == 'g'){ val *= 1000000000; }
+ return val;
+}
+
+//-- local_NowNs() - monotonic time in nanoseconds
+uint64_t local_NowNs(void)
+{
+ return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//-- local_Pin() - pin calling thread to logical CPU
+bool local_Pin(const int32_t cpu)
+{
+#ifdef __linux__
+ if(cpu < 0 || cpu >= CPU_SETSIZE){ return false; }
+ cpu_set_t set;
+ CPU_ZERO(&set);
+ CPU_SET(cpu,&set);
+ return (pthread_setaffinity_np(pthread_self(),sizeof(set),&set) == 0);
+#elif defined(_WIN32)
+ if(cpu < 0 || cpu >= 64){ return false; }
+ return (SetThreadAffinityMask(GetCurrentThread(),(DWORD_PTR)1 << cpu) != 0);
+#else
+ (void)cpu;
+ return false;
+#endif
+}
+
+//-- local_CpuList() - logical CPUs process may run on (affinity mask)
+void local_CpuList(std::vector<int32_t>& cpus)
+{
+ cpus.clear();
+#ifdef __linux__
+ cpu_set_t set;
+ CPU_ZERO(&set);
+ if(sched_getaffinity(0,sizeof(set),&set) == 0){
+   for(int32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu){ if(CPU_ISSET(cpu,&set)){ cpus.push_back(cpu); } }
+   }
+#endif
+ if(cpus.empty()){
+   uint32_t count = std::thread::hardware_concurrency();
+   if(count < 1){ count = 1; }
+   for(uint32_t cpu = 0; cpu < count; ++cpu){ cpus.push_back((int32_t)cpu); }
+   }
+}
+
+//-- local_Answers() - known answers by reference path, each on 2x different CPUs, stop if they differ
+void local_Answers(void)
+{
+ static const uint8_t hash_0[32] = { 0x2E,0xFD,0x64,0xA5,0x54,0x63,0xB5,0xB5,0x54,0xC4,0xA2,0xE2,0x2A,0x47,0x2D,0xA2,0x3B,0xB7,0x6E,0x63,0x75,0x8C,0xE3,0xC8,0x92,0x76,0xAB,0xF0,0xE9,0xAD,0x8B,0x15 };
+ alignas(32) static uint8_t second[STRESS_ANSWERS][32];
+
+ for(uint32_t j = 0; j < STRESS_ANSWERS; ++j){
+   memcpy(local_starts[j],hash_0,32);
+   local_starts[j][31] ^= (uint8_t)j;
+   }
+
+ //-- 2x runs of each answer, run k (answer k / 2) on thread k mod threads, CPUs differ if 2 or more
+ const uint32_t threads = (uint32_t)local_cpus.size();
+ std::vector<std::thread> workers;
+ for(uint32_t t = 0; t < threads; ++t){
+   workers.push_back(std::thread([t,threads]{
+     local_Pin(local_cpus[t]);
+     for(uint32_t k = t; k < 2 * STRESS_ANSWERS; k += threads){
+       uint8_t* out = (k & 1) ? second[k / 2] : local_answers[k / 2];
+       memcpy(out,local_starts[k / 2],32);
+       rsha256_ref(out,local_iters);
+       }
+     }));
+   }
+ for(std::thread& worker : workers){ worker.join(); }
+
+ for(uint32_t j = 0; j < STRESS_ANSWERS; ++j){
+   if(memcmp(local_answers[j],second[j],32)){ local_stop.store(true); }
+   }
+}
+
+//-- local_Worker() - pinned to CPU, kernel on known-answer starts, check each lane
+void local_Worker(const uint32_t idx)
+{
+ local_Pin(local_cpus[idx]);
+ local_stressstat* st = &local_stats[idx];
+ void (* const kernel)(uint8_t*,const uint64_t) = local_kernels[local_width];
+ const uint32_t lanes = (local_width > 0) ? local_width : 1;
+ alignas(64) uint8_t hashx4[32 * 4];
+
+ //-- each CPU and each check on other starts, lanes on different data
+ for(uint64_t n = 0; !local_stop.load(std::memory_order_relaxed); ++n){
+   const uint32_t first = (uint32_t)((idx * lanes + n * lanes) % STRESS_ANSWERS);
+   for(uint32_t l = 0; l < lanes; ++l){ memcpy(&hashx4[32 * l],local_starts[(first + l) % STRESS_ANSWERS],32); }
+
+   const uint64_t time0 = local_NowNs();
+   kernel(hashx4,local_iters);
+   const uint64_t time1 = local_NowNs();
+
+   if(n == 0 && local_cpus[idx] == local_faultcpu){ hashx4[0] ^= 0x01; }
+
+   uint64_t errors = 0;
+   for(uint32_t l = 0; l < lanes; ++l){ if(memcmp(&hashx4[32 * l],local_answers[(first + l) % STRESS_ANSWERS],32)){ ++errors; } }
+
+   if(errors > 0){
+     if(st->errors.load(std::memory_order_relaxed) == 0){ st->first_ns.store(time1 - local_startns,std::memory_order_relaxed); }
+     st->errors.store(st->errors.load(std::memory_order_relaxed) + errors,std::memory_order_relaxed);
+     }
+   st->checks.store(st->checks.load(std::memory_order_relaxed) + lanes,std::memory_order_relaxed);
+   st->iters.store(st->iters.load(std::memory_order_relaxed) + lanes * local_iters,std::memory_order_relaxed);
+   st->busy_ns.store(st->busy_ns.load(std::memory_order_relaxed) + (time1 - time0),std::memory_order_relaxed);
+   }
+}
+
+//-- local_Report() - progress, total throughput, checks and errors, CPUs with errors
+void local_Report(const uint64_t elapsed_ns)
+{
+ uint64_t iters = 0;
+ uint64_t checks = 0;
+ uint64_t errors = 0;
+ uint32_t bad = 0;
+ for(const local_stressstat& st : local_stats){
+   iters += st.iters.load(std::memory_order_relaxed);
+   checks += st.checks.load(std::memory_order_relaxed);
+   if(st.errors.load(std::memory_order_relaxed) > 0){ errors += st.errors.load(std::memory_order_relaxed); ++bad; }
+   }
+
+ const uint64_t secs = elapsed_ns / 1000000000ULL;
+ const double   mhs = (elapsed_ns > 0) ? (double)iters * 1000.0 / (double)elapsed_ns : 0.0;
+ printf("- %02" PRIu64 ":%02" PRIu64 ":%02" PRIu64 ": \33[1;32m%8.2f\33[0m MH/s (all CPUs), %" PRIu64 " checks, %s%" PRIu64 "\33[0m errors (%u CPUs)\n",
+        secs / 3600,(secs / 60) % 60,secs % 60,mhs,checks,(errors > 0) ? "\33[1;31m" : "\33[1;32m",errors,bad);
+}
+
+//-- local_Signal() - Ctrl-C, stop workers at end of current check
+void local_Signal(int sig)
+{
+ (void)sig;
+ local_stop.store(true);
+}
+
+//-- local_ANSISetup() - setup/init ANSI capability (needed for Windows)
+//-- local_ANSIRestore() - restore ANSI capability (needed for Windows)
+#ifdef _WIN32
+static HANDLE local_win_stdout;
+static DWORD  local_win_savemode = 0;
+void local_ANSISetup(void)
+{
+ local_win_stdout = GetStdHandle(STD_OUTPUT_HANDLE);
+ if(local_win_stdout == INVALID_HANDLE_VALUE){ return; }
+ if(!GetConsoleMode(local_win_stdout,&local_win_savemode)){ local_win_savemode = 0; return; }
+ if(!SetConsoleMode(local_win_stdout,(local_win_savemode | ENABLE_VIRTUAL_TERMINAL_PROCESSING))){ local_win_savemode = 0; return; }
+}
+void local_ANSIRestore(void)
+{
+ if(!SetConsoleMode(local_win_stdout,local_win_savemode)){ return; }
+}
+#else
+void local_ANSISetup(void) {}
+void local_ANSIRestore(void) {}
+#endif
+
+// <eof>